@@ -0,0 +1,72 @@
+#include "benchmark.hpp"
+#include "asyncLogger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+// per-call cost of the front end, measured call by call: p50/p99/p999
+
+static void printPercentiles(const char* name, std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<size_t>(q * static_cast<double>(samples.size() - 1))]; };
+    std::printf("%-40s p50 %8.1f ns  p99 %8.1f ns  p999 %8.1f ns  max %10.1f ns\n", name, at(0.5), at(0.99), at(0.999), samples.back());
+}
+
+template <typename LogCall>
+static std::vector<double> measureCalls(size_t calls, LogCall&& logCall)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> samples(calls);
+
+    for (size_t i = 0; i < calls; ++i)
+    {
+        auto start = Clock::now();
+        logCall(i);
+        samples[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    return samples;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t calls = argumentOr(argc, argv, 1, 1'000'000);
+
+    std::FILE* file = std::tmpfile();
+    if (!file)
+        return 1;
+
+    std::vector<double> clockOverhead = measureCalls(calls, [](size_t) {});
+    printPercentiles("(empty call: clock overhead)", clockOverhead);
+
+    {
+        AsyncLogger logger(1 << 16, AsyncLogger::fileSink(file), AsyncLogger::OverflowPolicy::Drop);
+        std::vector<double> samples = measureCalls(calls, [&](size_t i) { logger.log("order {} filled {} at {}", i, 100, 1.25); });
+        printPercentiles("AsyncLogger, drop on overflow", samples);
+        logger.flush();
+        std::printf("%-40s %llu\n", "  dropped", static_cast<unsigned long long>(logger.dropped()));
+    }
+
+    {
+        AsyncLogger logger(1 << 16, AsyncLogger::fileSink(file), AsyncLogger::OverflowPolicy::Block);
+        std::vector<double> samples = measureCalls(calls, [&](size_t i) { logger.log("order {} filled {} at {}", i, 100, 1.25); });
+        printPercentiles("AsyncLogger, block on overflow", samples);
+    }
+
+    {
+        std::mutex mutex;
+        std::vector<double> samples = measureCalls(calls, [&](size_t i)
+        {
+            std::lock_guard lock(mutex);
+            std::fprintf(file, "order %zu filled %d at %g\n", i, 100, 1.25);
+        });
+        printPercentiles("mutex + fprintf (synchronous)", samples);
+    }
+
+    std::fclose(file);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// tiny helpers shared by the benchmarks: no framework, just a steady clock and a printf
+
+// keeps the optimizer from throwing away the value being computed
+template <typename T> void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+// runs 'function' 'repetitions' times, returns the best run in nanoseconds
+template <typename Function>
+double measureBestNs(int repetitions, Function&& function)
+{
+    using Clock = std::chrono::steady_clock;
+    double best = 0;
+
+    for (int i = 0; i < repetitions; ++i)
+    {
+        auto start = Clock::now();
+        function();
+        double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (i == 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    return best;
+}
+
+inline void report(const char* name, double totalNs, double items)
+{
+    std::printf("%-48s %12.3f ms %10.3f ns/item\n", name, totalNs / 1e6, totalNs / items);
+}
+
+// optional positional integer argument, e.g. to shrink the data set on a small machine
+inline size_t argumentOr(int argc, char** argv, int index, size_t fallback)
+{
+    return argc > index ? static_cast<size_t>(std::strtoull(argv[index], nullptr, 10)) : fallback;
+}
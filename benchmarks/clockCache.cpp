@@ -0,0 +1,104 @@
+#include "benchmark.hpp"
+#include "clockCache.hpp"
+
+#include <cstdint>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// the LRU being replaced: every hit splices the entry to the front of the list
+class LruCache
+{
+public:
+
+    explicit LruCache(size_t capacity) : m_capacity(capacity) { m_index.reserve(capacity); }
+
+    const uint64_t* find(uint64_t key)
+    {
+        auto found = m_index.find(key);
+        if (found == m_index.end())
+            return nullptr;
+
+        m_order.splice(m_order.begin(), m_order, found->second);
+        return &found->second->second;
+    }
+
+    void insert(uint64_t key, uint64_t value)
+    {
+        if (m_order.size() == m_capacity)
+        {
+            m_index.erase(m_order.back().first);
+            m_order.pop_back();
+        }
+
+        m_order.emplace_front(key, value);
+        m_index.emplace(key, m_order.begin());
+    }
+
+private:
+
+    using Order = std::list<std::pair<uint64_t, uint64_t>>;
+
+    size_t                                           m_capacity;
+    Order                                            m_order;
+    std::unordered_map<uint64_t, Order::iterator>    m_index;
+};
+
+int main(int argc, char** argv)
+{
+    const size_t capacity = argumentOr(argc, argv, 1, 100'000);
+    const size_t lookups  = argumentOr(argc, argv, 2, 10'000'000);
+
+    // skewed key popularity: most lookups hit a small hot set, the tail mostly misses
+    std::mt19937_64 random(1);
+    std::vector<uint64_t> keys(lookups);
+    for (uint64_t& key : keys)
+    {
+        const double u = std::generate_canonical<double, 53>(random);
+        key = static_cast<uint64_t>(u * u * u * static_cast<double>(capacity) * 4);
+    }
+
+    std::printf("capacity %zu, %zu lookups, a miss inserts\n", capacity, lookups);
+
+    {
+        size_t hits = 0;
+        double ns = measureBestNs(3, [&]
+        {
+            ClockCache<uint64_t, uint64_t> cache(capacity);
+            hits = 0;
+            for (uint64_t key : keys)
+            {
+                if (cache.find(key))
+                    ++hits;
+                else
+                    cache.insertOrAssign(key, key);
+            }
+        });
+
+        report("ClockCache", ns, static_cast<double>(lookups));
+        std::printf("%-48s %11.1f%% hits\n", "", 100.0 * static_cast<double>(hits) / static_cast<double>(lookups));
+    }
+
+    {
+        size_t hits = 0;
+        double ns = measureBestNs(3, [&]
+        {
+            LruCache cache(capacity);
+            hits = 0;
+            for (uint64_t key : keys)
+            {
+                if (cache.find(key))
+                    ++hits;
+                else
+                    cache.insert(key, key);
+            }
+        });
+
+        report("std::list + std::unordered_map LRU", ns, static_cast<double>(lookups));
+        std::printf("%-48s %11.1f%% hits\n", "", 100.0 * static_cast<double>(hits) / static_cast<double>(lookups));
+    }
+
+    return 0;
+}
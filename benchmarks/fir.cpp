@@ -0,0 +1,76 @@
+#include "benchmark.hpp"
+#include "circularBuffer.hpp"
+#include "delayLine.hpp"
+
+#include <cmath>
+#include <vector>
+
+// multichannel FIR: mirrored DelayLine + SIMD dot product vs CircularBuffer<float> walked in two segments
+
+static float firOnRing(const CircularBuffer<float>& history, const std::vector<float>& reversed)
+{
+    // oldest-first history lined up with the reversed coefficients, split at the wrap
+    SpanPair<const float> segments = history.peek(history.size());
+    float sum = 0;
+    size_t k = 0;
+    for (float x : segments.m_first)
+        sum += reversed[k++] * x;
+    for (float x : segments.m_second)
+        sum += reversed[k++] * x;
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t channels   = argumentOr(argc, argv, 1, 64);
+    const size_t taps       = argumentOr(argc, argv, 2, 256);
+    const size_t samples    = argumentOr(argc, argv, 3, 19200);   // 100 ms at 192 kHz
+    const double sampleRate = 192000;
+
+    std::vector<float> coefficients(taps);
+    for (size_t k = 0; k < taps; ++k)
+        coefficients[k] = std::sin(0.01f * static_cast<float>(k)) / static_cast<float>(taps);
+    const std::vector<float> reversed(coefficients.rbegin(), coefficients.rend());
+
+    std::vector<float> input(samples);
+    for (size_t n = 0; n < samples; ++n)
+        input[n] = std::sin(0.001f * static_cast<float>(n));
+
+    std::printf("%zu channels x %zu taps, %zu samples per channel\n", channels, taps, samples);
+    const double items = static_cast<double>(channels * samples);
+
+    std::vector<CircularBuffer<float>> rings;
+    for (size_t c = 0; c < channels; ++c)
+    {
+        rings.emplace_back(taps);
+        for (size_t k = 0; k < taps; ++k)
+            rings.back().pushBack(0.0f);
+    }
+
+    double ringNs = measureBestNs(3, [&]
+    {
+        float sink = 0;
+        for (size_t c = 0; c < channels; ++c)
+            for (float x : input)
+            {
+                rings[c].pushBack(x);
+                sink += firOnRing(rings[c], reversed);
+            }
+        doNotOptimize(sink);
+    });
+    report("CircularBuffer, two scalar segments", ringNs, items);
+
+    std::vector<FirFilter<float>> filters(channels, FirFilter<float>(coefficients));
+    std::vector<float> output(samples);
+    double mirroredNs = measureBestNs(3, [&]
+    {
+        for (size_t c = 0; c < channels; ++c)
+            filters[c].process(input, output);
+        doNotOptimize(output.back());
+    });
+    report("FirFilter, mirrored DelayLine + SIMD", mirroredNs, items);
+
+    const double budgetNs = 1e9 / sampleRate / static_cast<double>(channels);
+    std::printf("real-time budget at 192 kHz x %zu channels: %.2f ns per channel-sample\n", channels, budgetNs);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "benchmark.hpp"
+#include "circularBuffer.hpp"
+
+#include <cstdint>
+
+// 512 bytes: 32 price levels of {price, quantity} per side is a typical order book snapshot
+struct OrderBookSnapshot
+{
+    struct Level
+    {
+        int32_t m_price    = 0;
+        int32_t m_quantity = 0;
+    };
+
+    Level m_bids[32];
+    Level m_asks[32];
+};
+static_assert(sizeof(OrderBookSnapshot) == 512);
+
+static int64_t depth(const OrderBookSnapshot& snapshot)
+{
+    int64_t sum = 0;
+    for (int i = 0; i < 32; ++i)
+        sum += snapshot.m_bids[i].m_quantity + snapshot.m_asks[i].m_quantity;
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    // default is 256 MiB of snapshots: far beyond the last level cache
+    const size_t capacity    = argumentOr(argc, argv, 1, size_t(1) << 19);
+    const int    repetitions = 5;
+
+    CircularBuffer<OrderBookSnapshot> ring = CircularBuffer<OrderBookSnapshot>(capacity);
+
+    OrderBookSnapshot snapshot;
+    for (size_t i = 0; i < capacity + capacity / 3; ++i)  // overflow, so the walk crosses the wrap
+    {
+        snapshot.m_bids[i % 32].m_quantity = static_cast<int32_t>(i);
+        ring.pushBack(snapshot);
+    }
+
+    std::printf("%zu snapshots, %zu MiB\n", ring.size(), ring.size() * sizeof(OrderBookSnapshot) >> 20);
+
+    double plainNs = measureBestNs(repetitions, [&]
+    {
+        int64_t sum = 0;
+        for (const OrderBookSnapshot& s : ring)
+            sum += depth(s);
+        doNotOptimize(sum);
+    });
+    report("iterator walk", plainNs, static_cast<double>(ring.size()));
+
+    const size_t distances[] = { 1, 2, 4, 8, 16 };
+    for (size_t distance : distances)
+    {
+        double prefetchedNs = measureBestNs(repetitions, [&]
+        {
+            int64_t sum = 0;
+            ring.forEachPrefetched([&](const OrderBookSnapshot& s) { sum += depth(s); }, distance);
+            doNotOptimize(sum);
+        });
+
+        std::string name = "forEachPrefetched, distance " + std::to_string(distance);
+        report(name.c_str(), prefetchedNs, static_cast<double>(ring.size()));
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "benchmark.hpp"
+#include "circularBuffer.hpp"
+#include "resampler.hpp"
+
+#include <cmath>
+#include <string>
+
+// streaming decimation/resampling from a high-rate ring into a low-rate history ring, block by block
+
+int main(int argc, char** argv)
+{
+    const size_t samples      = argumentOr(argc, argv, 1, 1 << 22);
+    const size_t blockSize    = argumentOr(argc, argv, 2, 4096);
+    const size_t tapsPerPhase = argumentOr(argc, argv, 3, 32);
+
+    struct Ratio { size_t m_up; size_t m_down; };
+    const Ratio ratios[] = { {1, 2}, {1, 4}, {1, 10}, {2, 3}, {147, 160} /* 48 -> 44.1 kHz */ };
+
+    std::printf("%zu input samples in blocks of %zu, %zu taps per phase\n", samples, blockSize, tapsPerPhase);
+
+    for (Ratio ratio : ratios)
+    {
+        CircularBuffer<float> input  = CircularBuffer<float>(blockSize);
+        CircularBuffer<float> output = CircularBuffer<float>(1 << 16);
+        Resampler<float> resampler(ratio.m_up, ratio.m_down, tapsPerPhase);
+
+        double ns = measureBestNs(3, [&]
+        {
+            size_t n = 0;
+            while (n < samples)
+            {
+                while (input.size() < input.capacity())
+                    input.pushBack(std::sin(0.001f * static_cast<float>(n++)));
+
+                resampler.process(input, output);
+            }
+            doNotOptimize(output.back());
+        });
+
+        std::string name = "ratio " + std::to_string(ratio.m_up) + "/" + std::to_string(ratio.m_down);
+        report(name.c_str(), ns, static_cast<double>(samples));
+        std::printf("%-48s %12.1f M input samples/s\n", "", static_cast<double>(samples) / ns * 1e3);
+    }
+
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "benchmark.hpp"
+#include "circularBuffer.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// capture-service style ingestion: big byte chunks into a ring that nobody reads soon
+int main(int argc, char** argv)
+{
+    const size_t capacity    = argumentOr(argc, argv, 1, size_t(256) << 20);   // 256 MiB ring
+    const size_t chunkSize   = argumentOr(argc, argv, 2, size_t(64) << 10);    // 64 KiB chunks
+    const size_t totalBytes  = capacity * 4;
+    const int    repetitions = 3;
+
+    std::vector<std::byte> chunk(chunkSize);
+    for (size_t i = 0; i < chunk.size(); ++i)
+        chunk[i] = static_cast<std::byte>(i);
+
+    CircularBuffer<std::byte> ring = CircularBuffer<std::byte>(capacity);
+    std::printf("ring %zu MiB, chunk %zu KiB, %zu MiB per run\n", capacity >> 20, chunkSize >> 10, totalBytes >> 20);
+
+    double pushBackNs = measureBestNs(repetitions, [&]
+    {
+        for (size_t written = 0; written < totalBytes; written += chunkSize)
+            for (std::byte b : chunk)
+                ring.pushBack(b);
+        doNotOptimize(ring.back());
+    });
+    report("pushBack per byte", pushBackNs, static_cast<double>(totalBytes));
+
+    double appendNs = measureBestNs(repetitions, [&]
+    {
+        for (size_t written = 0; written < totalBytes; written += chunkSize)
+            ring.append(chunk);
+        doNotOptimize(ring.back());
+    });
+    report("append (regular stores)", appendNs, static_cast<double>(totalBytes));
+
+    double streamingNs = measureBestNs(repetitions, [&]
+    {
+        for (size_t written = 0; written < totalBytes; written += chunkSize)
+            ring.appendStreaming(chunk);
+        doNotOptimize(ring.back());
+    });
+    report("appendStreaming (non-temporal stores)", streamingNs, static_cast<double>(totalBytes));
+
+    std::printf("GB/s: pushBack %.2f, append %.2f, appendStreaming %.2f\n",
+                totalBytes / pushBackNs, totalBytes / appendNs, totalBytes / streamingNs);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "benchmark.hpp"
+#include "timingWheel.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <queue>
+#include <random>
+#include <vector>
+
+// connection timeouts: schedule N timers, cancel half of them (the connections answered), expire the rest
+
+struct Connection : TimerNode
+{
+    uint64_t m_id = 0;
+};
+
+int main(int argc, char** argv)
+{
+    const size_t   timers  = argumentOr(argc, argv, 1, 1'000'000);
+    const uint64_t horizon = argumentOr(argc, argv, 2, 1'000'000);    // deadlines spread over that many ticks
+
+    std::mt19937_64 random(1);
+    std::vector<uint64_t> deadlines(timers);
+    for (uint64_t& deadline : deadlines)
+        deadline = 1 + random() % horizon;
+
+    std::printf("%zu timers over %llu ticks, half of them cancelled\n", timers, static_cast<unsigned long long>(horizon));
+    const double operations = static_cast<double>(timers) * 2;   // schedule + cancel or expire
+
+    {
+        std::vector<Connection> connections(timers);
+        uint64_t expired = 0;
+
+        double ns = measureBestNs(1, [&]
+        {
+            TimingWheel<4, 6> wheel;
+            for (size_t i = 0; i < timers; ++i)
+                wheel.schedule(connections[i], deadlines[i]);
+            for (size_t i = 0; i < timers; i += 2)
+                wheel.cancel(connections[i]);
+            expired = wheel.advance(horizon, [](TimerNode&) {});
+        });
+
+        report("TimingWheel<4, 6>", ns, operations);
+        std::printf("%-48s %12llu expired\n", "", static_cast<unsigned long long>(expired));
+    }
+
+    {
+        uint64_t expired = 0;
+        double ns = measureBestNs(1, [&]
+        {
+            // binary heap with lazy cancellation: a cancelled id is skipped when it surfaces
+            using Entry = std::pair<uint64_t /*deadline*/, size_t /*id*/>;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+            std::vector<bool> cancelled(timers);
+
+            for (size_t i = 0; i < timers; ++i)
+                heap.emplace(deadlines[i], i);
+            for (size_t i = 0; i < timers; i += 2)
+                cancelled[i] = true;
+
+            for (uint64_t now = 1; now <= horizon; ++now)
+                while (!heap.empty() && heap.top().first <= now)
+                {
+                    expired += cancelled[heap.top().second] ? 0 : 1;
+                    heap.pop();
+                }
+        });
+
+        report("std::priority_queue, lazy cancel", ns, operations);
+        std::printf("%-48s %12llu expired\n", "", static_cast<unsigned long long>(expired));
+    }
+
+    {
+        uint64_t expired = 0;
+        double ns = measureBestNs(1, [&]
+        {
+            std::multimap<uint64_t, size_t> queue;
+            std::vector<std::multimap<uint64_t, size_t>::iterator> handles(timers);
+
+            for (size_t i = 0; i < timers; ++i)
+                handles[i] = queue.emplace(deadlines[i], i);
+            for (size_t i = 0; i < timers; i += 2)
+                queue.erase(handles[i]);
+
+            for (uint64_t now = 1; now <= horizon; ++now)
+                while (!queue.empty() && queue.begin()->first <= now)
+                {
+                    ++expired;
+                    queue.erase(queue.begin());
+                }
+        });
+
+        report("std::multimap", ns, operations);
+        std::printf("%-48s %12llu expired\n", "", static_cast<unsigned long long>(expired));
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "benchmark.hpp"
+#include "circularBuffer.hpp"
+#include "tripleBuffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// fast writer, reader only wants the newest value: TripleBuffer vs mutex-guarded CircularBuffer::back()
+
+struct Quote
+{
+    uint64_t m_sequence = 0;
+    double   m_bid      = 0;
+    double   m_ask      = 0;
+    uint64_t m_volume   = 0;
+};
+
+template <typename Write, typename Read>
+static void run(const char* name, size_t reads, Write&& write, Read&& read)
+{
+    std::atomic<bool> stop = false;
+    std::atomic<uint64_t> writes = 0;
+
+    std::thread writer([&]
+    {
+        uint64_t i = 0;
+        while (!stop.load(std::memory_order_relaxed))
+            write(Quote{ ++i, 1.0, 2.0, i });
+        writes = i;
+    });
+
+    uint64_t sum = 0;
+    double readNs = measureBestNs(1, [&]
+    {
+        for (size_t i = 0; i < reads; ++i)
+            sum += read();
+    });
+
+    stop = true;
+    writer.join();
+
+    doNotOptimize(sum);
+    report(name, readNs, static_cast<double>(reads));
+    std::printf("%-48s %12.3f M writes during the run\n", "", static_cast<double>(writes.load()) / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+    const size_t reads = argumentOr(argc, argv, 1, 20'000'000);
+
+    TripleBuffer<Quote> latest;
+    run("TripleBuffer::read()", reads,
+        [&](const Quote& q) { latest.write(q); },
+        [&] { return latest.read().m_sequence; });
+
+    std::mutex mutex;
+    CircularBuffer<Quote> ring = CircularBuffer<Quote>(16);
+    ring.pushBack(Quote{});
+    run("mutex + CircularBuffer::back()", reads,
+        [&](const Quote& q) { std::lock_guard lock(mutex); ring.pushBack(q); },
+        [&] { std::lock_guard lock(mutex); return ring.back().m_sequence; });
+
+    return 0;
+}
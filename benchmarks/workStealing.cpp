@@ -0,0 +1,185 @@
+#include "benchmark.hpp"
+#include "circularBuffer.hpp"
+#include "workStealingDeque.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fork-join parallel fib: per-worker Chase-Lev deques vs one mutex-protected CircularBuffer task queue
+
+struct Task
+{
+    int               m_n      = 0;
+    uint64_t          m_result = 0;
+    std::atomic<bool> m_done   = false;
+};
+
+template <typename Scheduler> void run(Scheduler& scheduler, Task* task);
+
+static uint64_t serialFib(int n) { return n < 2 ? n : serialFib(n - 1) + serialFib(n - 2); }
+
+class StealingScheduler
+{
+    std::vector<std::unique_ptr<WorkStealingDeque<Task*>>> m_deques;
+    static inline thread_local size_t t_worker = 0;
+
+public:
+    explicit StealingScheduler(size_t workers)
+    {
+        for (size_t i = 0; i < workers; ++i)
+            m_deques.push_back(std::make_unique<WorkStealingDeque<Task*>>());
+    }
+
+    void bindWorker(size_t index) { t_worker = index; }
+
+    void spawn(Task* task) { m_deques[t_worker]->push(task); }
+
+    Task* findWork()
+    {
+        if (auto own = m_deques[t_worker]->pop())
+            return *own;
+
+        for (size_t i = 1; i < m_deques.size(); ++i)
+            if (auto stolen = m_deques[(t_worker + i) % m_deques.size()]->steal())
+                return *stolen;
+
+        return nullptr;
+    }
+};
+
+class SharedQueueScheduler
+{
+    std::mutex            m_mutex;
+    CircularBuffer<Task*> m_queue = CircularBuffer<Task*>(1 << 16);
+
+public:
+    explicit SharedQueueScheduler(size_t) {}
+
+    void bindWorker(size_t) {}
+
+    // returns false if the queue is full: the caller runs the task inline then
+    bool trySpawn(Task* task)
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_queue.size() == m_queue.capacity())
+            return false;
+        m_queue.pushBack(task);
+        return true;
+    }
+
+    void spawn(Task* task)
+    {
+        if (!trySpawn(task))
+            run(*this, task);
+    }
+
+    Task* findWork()
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_queue.empty())
+            return nullptr;
+        Task* task = m_queue.front();
+        m_queue.popFront();
+        return task;
+    }
+};
+
+constexpr int k_serialCutoff = 20;
+
+template <typename Scheduler> uint64_t fib(Scheduler& scheduler, int n);
+
+template <typename Scheduler>
+void run(Scheduler& scheduler, Task* task)
+{
+    task->m_result = fib(scheduler, task->m_n);
+    task->m_done.store(true, std::memory_order_release);
+}
+
+template <typename Scheduler>
+uint64_t fib(Scheduler& scheduler, int n)
+{
+    if (n < k_serialCutoff)
+        return serialFib(n);
+
+    Task child;
+    child.m_n = n - 1;
+    scheduler.spawn(&child);
+
+    uint64_t result = fib(scheduler, n - 2);
+
+    // help with other work until the child is done, whoever has taken it
+    while (!child.m_done.load(std::memory_order_acquire))
+    {
+        if (Task* task = scheduler.findWork())
+            run(scheduler, task);
+        else
+            std::this_thread::yield();
+    }
+
+    return result + child.m_result;
+}
+
+template <typename Scheduler>
+double benchmark(size_t workers, int n, uint64_t& result)
+{
+    return measureBestNs(3, [&]
+    {
+        Scheduler scheduler(workers);
+        std::atomic<bool> stop = false;
+        std::vector<std::thread> threads;
+
+        for (size_t i = 1; i < workers; ++i)
+        {
+            threads.emplace_back([&, i]
+            {
+                scheduler.bindWorker(i);
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    if (Task* task = scheduler.findWork())
+                        run(scheduler, task);
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        scheduler.bindWorker(0);
+        result = fib(scheduler, n);
+
+        stop = true;
+        for (std::thread& t : threads)
+            t.join();
+    });
+}
+
+int main(int argc, char** argv)
+{
+    const int    n       = static_cast<int>(argumentOr(argc, argv, 1, 36));
+    const size_t workers = argumentOr(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    std::printf("fib(%d), %zu workers, serial cutoff %d\n", n, workers, k_serialCutoff);
+
+    uint64_t expected = 0;
+    double serialNs = measureBestNs(1, [&] { expected = serialFib(n); });
+    report("serial", serialNs, 1);
+
+    uint64_t stealingResult = 0;
+    double stealingNs = benchmark<StealingScheduler>(workers, n, stealingResult);
+    report("WorkStealingDeque per worker", stealingNs, 1);
+
+    uint64_t sharedResult = 0;
+    double sharedNs = benchmark<SharedQueueScheduler>(workers, n, sharedResult);
+    report("mutex + shared CircularBuffer queue", sharedNs, 1);
+
+    if (stealingResult != expected || sharedResult != expected)
+    {
+        std::printf("wrong result!\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "boundedQueue.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * Asynchronous logger: the calling thread only copies a compact binary record into a lock-free ring,
+ * a background thread formats the records and hands them to the sink in large batches.
+ *
+ *     AsyncLogger logger(1 << 16, AsyncLogger::fileSink(stderr));
+ *     logger.log("order {} filled at {}", orderId, price);
+ *
+ * The record is the format string pointer (it must have static storage duration, e.g. a literal),
+ * a pointer to the formatter instantiated for the argument types and the raw bytes of the arguments.
+ * Arguments must be trivially copyable: numbers, bools, chars, enums and pointers, which are logged as addresses.
+ * Only '{}' placeholders are supported.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+class AsyncLogger
+{
+public:
+
+    enum class OverflowPolicy
+    {
+        Drop,       // a full ring drops the record and counts it, see dropped()
+        Block,      // a full ring makes the caller wait for the flusher
+    };
+
+    using Sink = std::function<void(std::string_view batch)>;
+
+    static constexpr size_t k_argumentBytes = 48;   // 64-byte records on 64-bit platforms
+
+    AsyncLogger(size_t capacity, Sink sink, OverflowPolicy policy = OverflowPolicy::Drop, size_t batchBytes = 64 * 1024)
+        : m_records(capacity)
+        , m_sink(std::move(sink))
+        , m_policy(policy)
+        , m_batchBytes(batchBytes)
+        , m_flusher([this] { flusherLoop(); })
+    {
+    }
+
+    AsyncLogger(const AsyncLogger&)            = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    ~AsyncLogger()
+    {
+        flush();
+        m_stop.store(true, std::memory_order_release);
+        m_flusher.join();
+    }
+
+    static Sink fileSink(std::FILE* file)
+    {
+        return [file](std::string_view batch)
+        {
+            std::fwrite(batch.data(), 1, batch.size(), file);
+            std::fflush(file);
+        };
+    }
+
+    // returns false if the record was dropped because of the overflow
+    template <typename... Args>
+    bool log(const char* format, const Args&... args)
+    {
+        static_assert((std::is_trivially_copyable_v<Args> && ...), "arguments are copied as raw bytes");
+        static_assert((0 + ... + sizeof(Args)) <= k_argumentBytes, "too many arguments for a single record");
+
+        auto fill = [&](Record& record)
+        {
+            record.m_formatter = &formatRecord<Args...>;
+            record.m_format    = format;
+
+            std::byte* out = record.m_arguments;
+            ((std::memcpy(out, &args, sizeof(Args)), out += sizeof(Args)), ...);
+        };
+
+        return push(fill);
+    }
+
+    // blocks until everything logged before the call is handed to the sink
+    void flush()
+    {
+        std::atomic<bool> done = false;
+        std::atomic<bool>* donePointer = &done;
+
+        auto fill = [&](Record& record)
+        {
+            record.m_formatter = nullptr;   // a marker, not a log line
+            record.m_format    = nullptr;
+            std::memcpy(record.m_arguments, &donePointer, sizeof(donePointer));
+        };
+
+        while (!m_records.tryPushWith(fill))
+            std::this_thread::yield();
+
+        while (!done.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+
+    using Formatter = void (*)(const char* format, const std::byte* arguments, std::string& out);
+
+    struct Record
+    {
+        Formatter   m_formatter = nullptr;
+        const char* m_format    = nullptr;
+        std::byte   m_arguments[k_argumentBytes];
+    };
+
+    BoundedQueue<Record>  m_records;
+    Sink                  m_sink;
+    const OverflowPolicy  m_policy;
+    const size_t          m_batchBytes;
+    std::atomic<uint64_t> m_dropped = 0;
+    std::atomic<bool>     m_stop    = false;
+    std::thread           m_flusher;            // the last one: starts when everything else is initialized
+
+    template <typename Fill>
+    bool push(Fill& fill)
+    {
+        if (m_records.tryPushWith(fill))
+            return true;
+
+        if (m_policy == OverflowPolicy::Drop)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        do
+        {
+            std::this_thread::yield();
+        }
+        while (!m_records.tryPushWith(fill));
+
+        return true;
+    }
+
+    void flusherLoop()
+    {
+        using namespace std::chrono_literals;
+
+        std::string batch;
+        batch.reserve(m_batchBytes + 1024);
+
+        std::atomic<bool>* flushed = nullptr;
+        auto consume = [&](Record& record)
+        {
+            if (record.m_formatter)
+                record.m_formatter(record.m_format, record.m_arguments, batch);
+            else
+                std::memcpy(&flushed, record.m_arguments, sizeof(flushed));
+        };
+
+        for (;;)
+        {
+            bool gotAny = false;
+            while (batch.size() < m_batchBytes && !flushed && m_records.tryPopWith(consume))
+                gotAny = true;
+
+            if (!batch.empty() && (!gotAny || flushed || batch.size() >= m_batchBytes))
+            {
+                m_sink(batch);
+                batch.clear();
+            }
+
+            if (flushed)
+            {
+                flushed->store(true, std::memory_order_release);
+                flushed = nullptr;
+                continue;
+            }
+
+            if (!gotAny)
+            {
+                if (m_stop.load(std::memory_order_acquire))
+                    return;
+                std::this_thread::sleep_for(100us);
+            }
+        }
+    }
+
+    template <typename... Args>
+    static void formatRecord(const char* format, const std::byte* arguments, std::string& out)
+    {
+        std::tuple<Args...> values;
+        std::apply([&](Args&... value)
+        {
+            ((std::memcpy(&value, arguments, sizeof(Args)), arguments += sizeof(Args)), ...);
+        }, values);
+
+        std::string_view rest = format;
+        std::apply([&](const Args&... value)
+        {
+            (appendPlaceholder(rest, value, out), ...);
+        }, values);
+
+        out += rest;
+        out += '\n';
+    }
+
+    template <typename Arg>
+    static void appendPlaceholder(std::string_view& rest, const Arg& value, std::string& out)
+    {
+        const size_t placeholder = rest.find("{}");
+        if (placeholder == std::string_view::npos)
+            return;     // more arguments than placeholders
+
+        out += rest.substr(0, placeholder);
+        appendValue(value, out);
+        rest.remove_prefix(placeholder + 2);
+    }
+
+    template <typename Arg>
+    static void appendValue(const Arg& value, std::string& out)
+    {
+        char text[64];
+        std::to_chars_result result = {};
+
+        if constexpr (std::is_same_v<Arg, bool>)
+        {
+            out += value ? "true" : "false";
+            return;
+        }
+        else if constexpr (std::is_same_v<Arg, char>)
+        {
+            out += value;
+            return;
+        }
+        else if constexpr (std::is_enum_v<Arg>)
+        {
+            result = std::to_chars(std::begin(text), std::end(text), static_cast<std::underlying_type_t<Arg>>(value));
+        }
+        else if constexpr (std::is_pointer_v<Arg>)
+        {
+            out += "0x";
+            result = std::to_chars(std::begin(text), std::end(text), reinterpret_cast<uintptr_t>(value), 16);
+        }
+        else if constexpr (std::is_arithmetic_v<Arg>)
+        {
+            result = std::to_chars(std::begin(text), std::end(text), value);
+        }
+        else
+        {
+            static_assert(!sizeof(Arg), "don't know how to format this type");
+        }
+
+        out.append(text, result.ptr);
+    }
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "circularBufferConfig.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * Bounded lock-free multi-producer multi-consumer queue (D. Vyukov's array-based design).
+ *
+ * A ring of slots, each with a sequence number telling whose turn it is: a producer may fill the slot when
+ * the sequence equals its ticket, a consumer may take it when the sequence is ticket + 1. Tickets are
+ * claimed with a CAS on the enqueue/dequeue position, so every operation costs one CAS when uncontended.
+ * Unlike CircularBuffer it never overwrites: pushing to a full queue fails and the caller decides what to do.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename T>
+class BoundedQueue
+{
+    struct Slot
+    {
+        std::atomic<size_t> m_sequence = 0;
+        T                   m_value    = {};
+    };
+
+public:
+
+    // capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity)
+        : m_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+        , m_slots(std::make_unique<Slot[]>(m_mask + 1))
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&)            = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // approximate when called concurrently
+    size_t size() const
+    {
+        size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+        size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    // calls fill(T& slot) to construct the element in place, returns false if the queue is full
+    template <typename Fill>
+    bool tryPushWith(Fill&& fill)
+    {
+        size_t position = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot& slot = m_slots[position & m_mask];
+            const size_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    fill(slot.m_value);
+                    slot.m_sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;   // full: the slot hasn't been consumed since the previous lap
+            }
+            else
+            {
+                position = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename Convertible>
+    bool tryPush(Convertible&& value)
+    {
+        return tryPushWith([&](T& slot) { slot = std::forward<Convertible>(value); });
+    }
+
+    // calls consume(T& slot) on the oldest element, returns false if the queue is empty
+    template <typename Consume>
+    bool tryPopWith(Consume&& consume)
+    {
+        size_t position = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot& slot = m_slots[position & m_mask];
+            const size_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+            if (difference == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    consume(slot.m_value);
+                    slot.m_sequence.store(position + m_mask + 1, std::memory_order_release);   // free for the next lap
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;   // empty
+            }
+            else
+            {
+                position = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out)
+    {
+        return tryPopWith([&](T& slot) { out = std::move(slot); });
+    }
+
+private:
+
+    const size_t            m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+
+    alignas(detail::k_cacheLineSize) std::atomic<size_t> m_enqueuePos = 0;
+    alignas(detail::k_cacheLineSize) std::atomic<size_t> m_dequeuePos = 0;
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
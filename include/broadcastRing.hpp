@@ -0,0 +1,175 @@
+#pragma once
+
+#include "circularBufferConfig.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/**
+ * Single-writer, multi-reader lossy broadcast ring.
+ *
+ * The writer never waits for anybody: like CircularBuffer::pushBack it just overwrites the oldest element.
+ * Every reader has its own cursor and sees every element unless it is lapped by the writer. A lapped reader
+ * notices it via per-slot sequence stamps, skips ahead to the oldest element which is still valid and counts
+ * how many elements it has lost.
+ *
+ * Each slot is a tiny seqlock: the stamp is odd while the slot is being written and 2 * (sequence + 1) once
+ * the element with that sequence is complete. The payload is copied through relaxed atomic words, so a reader
+ * racing with the writer gets a torn copy which the stamp check then rejects, never undefined behavior.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename T>
+class BroadcastRing
+{
+    static_assert(std::is_trivially_copyable_v<T>, "readers copy elements while they may be overwritten");
+
+    static constexpr size_t k_wordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct alignas(detail::k_cacheLineSize) Slot
+    {
+        std::atomic<uint64_t> m_stamp = 0;
+        std::atomic<uint64_t> m_words[k_wordCount] = {};
+    };
+
+    static uint64_t writingStamp(uint64_t sequence)  { return 2 * sequence + 1; }
+    static uint64_t completeStamp(uint64_t sequence) { return 2 * sequence + 2; }
+
+public:
+
+    class Reader;
+
+    // capacity is rounded up to a power of two
+    explicit BroadcastRing(size_t capacity)
+        : m_capacity(std::bit_ceil(std::max<size_t>(capacity, 1)))
+        , m_slots(std::make_unique<Slot[]>(m_capacity))
+    {
+    }
+
+    BroadcastRing(const BroadcastRing&)            = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    size_t capacity() const { return m_capacity; }
+
+    // sequence the next pushed element will get, i.e. how many were pushed so far
+    uint64_t endSequence() const { return m_published.load(std::memory_order_acquire); }
+
+    // writer only
+    void pushBack(const T& value)
+    {
+        const uint64_t sequence = m_published.load(std::memory_order_relaxed);
+        Slot& slot = slotOf(sequence);
+
+        uint64_t words[k_wordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        slot.m_stamp.store(writingStamp(sequence), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);     // readers must not see new words with the old stamp
+
+        for (size_t i = 0; i < k_wordCount; ++i)
+            slot.m_words[i].store(words[i], std::memory_order_relaxed);
+
+        slot.m_stamp.store(completeStamp(sequence), std::memory_order_release);
+        m_published.store(sequence + 1, std::memory_order_release);
+    }
+
+    // a reader which will see elements pushed from now on
+    Reader makeReader() const { return Reader(*this, endSequence()); }
+
+    // a reader which starts with the oldest element still in the ring
+    Reader makeReaderFromOldest() const
+    {
+        const uint64_t end = endSequence();
+        return Reader(*this, end > m_capacity ? end - m_capacity : 0);
+    }
+
+private:
+
+    const size_t             m_capacity;
+    std::unique_ptr<Slot[]>  m_slots;
+
+    alignas(detail::k_cacheLineSize) std::atomic<uint64_t> m_published = 0;
+
+    Slot&       slotOf(uint64_t sequence)       { return m_slots[sequence & (m_capacity - 1)]; }
+    const Slot& slotOf(uint64_t sequence) const { return m_slots[sequence & (m_capacity - 1)]; }
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
+
+template <typename T>
+class BroadcastRing<T>::Reader
+{
+    const BroadcastRing* m_ring     = nullptr;
+    uint64_t             m_sequence = 0;    // next sequence to read
+    uint64_t             m_lost     = 0;
+
+    friend class BroadcastRing;
+
+    Reader(const BroadcastRing& ring, uint64_t sequence)
+        : m_ring(&ring)
+        , m_sequence(sequence)
+    {
+    }
+
+public:
+
+    Reader() = default;
+
+    uint64_t position() const { return m_sequence; }   // sequence of the next element to be read
+    uint64_t lost() const     { return m_lost; }       // elements overwritten before this reader got to them
+
+    // copies the next element to 'out', returns false if there is nothing new yet
+    bool tryRead(T& out)
+    {
+        assert(m_ring != nullptr);
+
+        for (;;)
+        {
+            const uint64_t end = m_ring->endSequence();
+            if (m_sequence >= end)
+                return false;
+
+            if (end - m_sequence > m_ring->m_capacity)
+                skipTo(end - m_ring->m_capacity);           // lapped: jump to the oldest element still in the ring
+
+            const Slot& slot = m_ring->slotOf(m_sequence);
+            const uint64_t stampBefore = slot.m_stamp.load(std::memory_order_acquire);
+            if (stampBefore != completeStamp(m_sequence))
+            {
+                // the writer is already over this slot again: retry with the fresh end sequence
+                skipTo(m_sequence + 1);
+                continue;
+            }
+
+            uint64_t words[k_wordCount];
+            for (size_t i = 0; i < k_wordCount; ++i)
+                words[i] = slot.m_words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);   // the copy must complete before re-checking
+            if (slot.m_stamp.load(std::memory_order_relaxed) != stampBefore)
+            {
+                skipTo(m_sequence + 1);                     // torn copy: overwritten while reading
+                continue;
+            }
+
+            std::memcpy(&out, words, sizeof(T));
+            ++m_sequence;
+            return true;
+        }
+    }
+
+private:
+
+    void skipTo(uint64_t sequence)
+    {
+        if (sequence > m_sequence)
+        {
+            m_lost    += sequence - m_sequence;
+            m_sequence = sequence;
+        }
+    }
+};
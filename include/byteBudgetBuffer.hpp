@@ -0,0 +1,121 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+// default size of an element: the object itself plus what its size() elements occupy, e.g. string or vector payloads
+struct PayloadSize
+{
+    template <typename T>
+    size_t operator()(const T& value) const
+    {
+        if constexpr (requires { value.size(); typename T::value_type; })
+            return sizeof(T) + value.size() * sizeof(typename T::value_type);
+        else
+            return sizeof(T);
+    }
+};
+
+/**
+ * Ring of variable-size payloads whose capacity is a byte budget rather than an element count.
+ *
+ * Elements are kept in a CircularBuffer and the sum of 'sizeOf(element)' over them is tracked. pushBack()
+ * evicts from the front until the new element fits in the budget, so the memory held stays predictable
+ * whatever the mix of small and large payloads. The element count of the CircularBuffer stays as a
+ * secondary limit: when it's reached the front is evicted as usual.
+ *
+ * Elements are only accessible as const, so that a payload can't grow behind the byte count's back.
+ */
+template <typename T, typename SizeOf = PayloadSize, typename Buffer = VectorBuffer<T>>
+class ByteBudgetBuffer
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    struct PrivateDummy;
+
+public:
+
+    using const_iterator = typename CircularBuffer<T, Buffer>::const_iterator;
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    ByteBudgetBuffer(SizeType maxElements, size_t byteBudget, SizeOf sizeOf = SizeOf())
+        : m_elements  (maxElements)
+        , m_byteBudget(byteBudget)
+        , m_sizeOf    (std::move(sizeOf))
+    {
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    explicit ByteBudgetBuffer(size_t byteBudget, SizeOf sizeOf = SizeOf())
+        : m_elements  ()
+        , m_byteBudget(byteBudget)
+        , m_sizeOf    (std::move(sizeOf))
+    {
+    }
+
+    size_t size() const       { return m_elements.size(); }
+    size_t capacity() const   { return m_elements.capacity(); }    // element count limit
+    bool   empty() const      { return m_elements.empty(); }
+    size_t bytes() const      { return m_bytes; }
+    size_t byteBudget() const { return m_byteBudget; }
+
+    const_iterator begin() const { return m_elements.begin(); }
+    const_iterator end() const   { return m_elements.end(); }
+    const T&       front() const { return m_elements.front(); }
+    const T&       back() const  { return m_elements.back(); }
+
+    auto mostRecent(size_t count) const & { return m_elements.mostRecent(count); }
+    void mostRecent(size_t count) && = delete;
+
+    const CircularBuffer<T, Buffer>& elements() const { return m_elements; }
+
+    // evicts from the front until 'value' fits. An element larger than the whole budget is rejected: returns false
+    // and leaves the buffer untouched
+    template <typename Convertible>
+    bool pushBack(Convertible&& value)
+    {
+        T element(std::forward<Convertible>(value));
+        const size_t elementBytes = m_sizeOf(std::as_const(element));
+        if (elementBytes > m_byteBudget)
+            return false;
+
+        while (!empty() && (m_bytes + elementBytes > m_byteBudget || size() == capacity()))
+            popFront();
+
+        m_elements.pushBack(std::move(element));
+        m_bytes += elementBytes;
+        return true;
+    }
+
+    void popFront()
+    {
+        assert(!empty());
+        m_bytes -= m_sizeOf(front());
+        {
+            // CircularBuffer::popFront() leaves the element in its slot: move the payload out to free it now
+            [[maybe_unused]] T released = std::move(m_elements.front());
+        }
+        m_elements.popFront();
+    }
+
+    // a smaller budget evicts right away
+    void setByteBudget(size_t byteBudget)
+    {
+        m_byteBudget = byteBudget;
+        while (m_bytes > m_byteBudget)
+            popFront();
+    }
+
+private:
+
+    CircularBuffer<T, Buffer> m_elements;
+    size_t                    m_byteBudget;
+    size_t                    m_bytes = 0;
+    SizeOf                    m_sizeOf;
+};
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * Bounded coroutine channel on top of CircularBuffer:
+ *
+ *     co_await channel.push(value);    // suspends while the ring is full
+ *     T value = co_await channel.pop(); // suspends while the ring is empty
+ *
+ * Suspended coroutines are parked in intrusive FIFO lists: the awaiters live in the coroutine frames,
+ * so parking allocates nothing. Whenever space or data appears, all the waiters which can proceed now are
+ * handed to the executor at once and it resumes them as a batch, instead of ping-ponging between stages.
+ * A channel of capacity 0 is a rendezvous: every value goes from a parked pusher straight to a popper.
+ * Not thread-safe: every coroutine using a channel has to run on the same executor.
+ */
+
+// executes ready coroutines on the calling thread, in batches
+class SingleThreadedExecutor
+{
+    std::vector<std::coroutine_handle<>> m_ready;
+    std::vector<std::coroutine_handle<>> m_batch;
+
+public:
+
+    void schedule(std::coroutine_handle<> handle) { m_ready.push_back(handle); }
+
+    // runs until there is nothing ready
+    void run()
+    {
+        while (!m_ready.empty())
+        {
+            std::swap(m_ready, m_batch);
+            for (std::coroutine_handle<> handle : m_batch)
+                handle.resume();
+            m_batch.clear();
+        }
+    }
+};
+
+// fire-and-forget coroutine which starts when spawned on an executor and frees itself when done
+class ChannelTask
+{
+public:
+    struct promise_type
+    {
+        ChannelTask         get_return_object()   { return ChannelTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend()     { return {}; }
+        std::suspend_never  final_suspend() noexcept { return {}; }
+        void                return_void()         {}
+        void                unhandled_exception() { std::terminate(); }
+    };
+
+    ChannelTask(ChannelTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    ChannelTask(const ChannelTask&)            = delete;
+    ChannelTask& operator=(const ChannelTask&) = delete;
+    ChannelTask& operator=(ChannelTask&&)      = delete;
+
+    ~ChannelTask()
+    {
+        if (m_handle)
+            m_handle.destroy();     // has never been spawned
+    }
+
+    template <typename Executor>
+    void spawn(Executor& executor) &&
+    {
+        executor.schedule(std::exchange(m_handle, nullptr));
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+
+    explicit ChannelTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+};
+
+template <typename T, typename Buffer = VectorBuffer<T>, typename Executor = SingleThreadedExecutor>
+class Channel
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    // singly-linked FIFO of awaiters, which are linked through their 'm_next' member
+    template <typename Waiter>
+    class WaiterList
+    {
+        Waiter* m_first = nullptr;
+        Waiter* m_last  = nullptr;
+
+    public:
+        bool    empty() const { return m_first == nullptr; }
+        Waiter& front() const { return *m_first; }
+
+        void pushBack(Waiter& waiter)
+        {
+            waiter.m_next = nullptr;
+            if (m_last)
+                m_last->m_next = &waiter;
+            else
+                m_first = &waiter;
+            m_last = &waiter;
+        }
+
+        void popFront()
+        {
+            m_first = m_first->m_next;
+            if (!m_first)
+                m_last = nullptr;
+        }
+    };
+
+    struct PrivateDummy;
+
+public:
+
+    class PushAwaiter;
+    class PopAwaiter;
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    Channel(Executor& executor, SizeType capacity)
+        : m_executor(executor)
+        , m_buffer(capacity)
+    {
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    explicit Channel(Executor& executor)
+        : m_executor(executor)
+    {
+    }
+
+    Channel(const Channel&)            = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    size_t size() const     { return m_buffer.size(); }
+    size_t capacity() const { return m_buffer.capacity(); }
+
+    template <typename Convertible>
+    PushAwaiter push(Convertible&& value) { return PushAwaiter(*this, T(std::forward<Convertible>(value))); }
+
+    PopAwaiter pop() { return PopAwaiter(*this); }
+
+private:
+
+    // invariants: pushers wait only while the buffer is full, poppers wait only while it's empty, so with
+    // capacity 0 both may find the other side parked
+    Executor&                 m_executor;
+    CircularBuffer<T, Buffer> m_buffer;
+    WaiterList<PushAwaiter>   m_pushWaiters;
+    WaiterList<PopAwaiter>    m_popWaiters;
+
+    bool full() const { return m_buffer.size() == m_buffer.capacity(); }
+
+    // space has appeared: move the values of as many parked pushers as fit, resume them all
+    void admitPushers()
+    {
+        while (!full() && !m_pushWaiters.empty())
+        {
+            PushAwaiter& pusher = m_pushWaiters.front();
+            m_pushWaiters.popFront();
+
+            m_buffer.pushBack(std::move(pusher.m_value));
+            m_executor.schedule(pusher.m_handle);
+        }
+    }
+};
+
+template <typename T, typename Buffer, typename Executor>
+class Channel<T, Buffer, Executor>::PushAwaiter
+{
+    Channel&                m_channel;
+    T                       m_value;
+    std::coroutine_handle<> m_handle;
+    PushAwaiter*            m_next = nullptr;
+
+    friend class Channel;
+    friend class WaiterList<PushAwaiter>;
+
+    PushAwaiter(Channel& channel, T&& value) : m_channel(channel), m_value(std::move(value)) {}
+
+public:
+
+    bool await_ready()
+    {
+        if (!m_channel.m_popWaiters.empty())
+        {
+            // a consumer is parked, so the buffer is empty: hand the value over directly
+            PopAwaiter& popper = m_channel.m_popWaiters.front();
+            m_channel.m_popWaiters.popFront();
+
+            popper.m_value.emplace(std::move(m_value));
+            m_channel.m_executor.schedule(popper.m_handle);
+            return true;
+        }
+
+        if (m_channel.full())
+            return false;
+
+        m_channel.m_buffer.pushBack(std::move(m_value));
+        return true;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_handle = handle;
+        m_channel.m_pushWaiters.pushBack(*this);
+    }
+
+    void await_resume() {}   // if suspended, the value has already been moved into the buffer by admitPushers() or taken by a popper
+};
+
+template <typename T, typename Buffer, typename Executor>
+class Channel<T, Buffer, Executor>::PopAwaiter
+{
+    Channel&                m_channel;
+    std::optional<T>        m_value;     // set if a pusher has handed its value over directly
+    std::coroutine_handle<> m_handle;
+    PopAwaiter*             m_next = nullptr;
+
+    friend class Channel;
+    friend class WaiterList<PopAwaiter>;
+
+    explicit PopAwaiter(Channel& channel) : m_channel(channel) {}
+
+public:
+
+    bool await_ready()
+    {
+        if (!m_channel.m_buffer.empty())
+            return true;
+
+        if (!m_channel.m_pushWaiters.empty())
+        {
+            // empty and yet a producer is parked: capacity 0, take its value directly
+            PushAwaiter& pusher = m_channel.m_pushWaiters.front();
+            m_channel.m_pushWaiters.popFront();
+
+            m_value.emplace(std::move(pusher.m_value));
+            m_channel.m_executor.schedule(pusher.m_handle);
+            return true;
+        }
+
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_handle = handle;
+        m_channel.m_popWaiters.pushBack(*this);
+    }
+
+    T await_resume()
+    {
+        if (m_value)
+            return std::move(*m_value);
+
+        T value = std::move(m_channel.m_buffer.front());
+        m_channel.m_buffer.popFront();
+        m_channel.admitPushers();
+        return value;
+    }
+};
@@ -1,14 +1,27 @@
 #pragma once
 
+#include "circularBufferConfig.hpp"
+
 #include <iterator>
 #include <vector>
+#include <algorithm>    // min
 
 #include <cstddef>      // ptrdiff_t
 #include <type_traits>
 #include <cassert>
+#include <stdexcept>    // out_of_range
 
 #include <ranges>   // for subrange
 
+#include <span>
+#include <cstring>      // memcpy
+#include <cstdint>      // uintptr_t
+#include <utility>      // as_const
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>  // _mm_prefetch
+#endif
+
 // adds begin/end/size functions to its 'Derived' subclass 
 // assumes that there is getUnderlyingType() method returns a reference to the underlying class that supports std::begin/end/size, 
 // e.g. 'std::vector<T>& getUnderlyingType();'
@@ -63,6 +76,17 @@ public:
     // implicit constructors are just fine
 };
 
+// up to two contiguous pieces of a ring: the part before the buffer end and the wrapped part after the buffer begin
+template <typename Element>
+struct SpanPair
+{
+    std::span<Element> m_first;
+    std::span<Element> m_second;
+
+    size_t size() const  { return m_first.size() + m_second.size(); }
+    bool   empty() const { return size() == 0; }
+};
+
 /**
  * Constructs a ring buffer in the 'Buffer' container adapter. 
  * It's important that the Buffer will reserve an additional sentinel element
@@ -129,6 +153,7 @@ public:
         : m_buffer(other.m_buffer)
         , m_head  (bufferBegin() + getIndex(other.m_buffer, other.m_head))
         , m_tail  (bufferBegin() + getIndex(other.m_buffer, other.m_tail))
+        , m_headSequence(other.m_headSequence)
     {
     }
 
@@ -157,6 +182,7 @@ public:
             m_buffer = copy.m_buffer;
             m_head = bufferBegin() + getIndex(copy.m_buffer, copy.m_head);
             m_tail = bufferBegin() + getIndex(copy.m_buffer, copy.m_tail);
+            m_headSequence = copy.m_headSequence;
         }
         else
         {
@@ -174,6 +200,7 @@ public:
     }
 
     bool empty() const                { return m_tail == m_head; }
+    size_t capacity() const           { return std::size(m_buffer) - 1; }   // minus sentinel
 
     iterator       begin()            { return iterator      (bufferBegin(), bufferEnd(), m_head); }
     const_iterator begin()  const     { return const_iterator(bufferBegin(), bufferEnd(), m_head); }  // non-const buffer is needed for generic non-const iterator
@@ -206,6 +233,56 @@ public:
 
     void mostRecent(size_t count) && = delete;                  // can't return a subrange of a temporary
 
+    /*
+     * Sequence numbers: every pushed element gets the next number of a 64-bit counter, so readers can track
+     * their position by an absolute number which survives overwrites. All lookups are O(1) head arithmetic
+    */
+
+    uint64_t frontSequence() const { return m_headSequence; }                  // sequence of front(), if any
+    uint64_t endSequence() const   { return m_headSequence + size(); }         // sequence the next pushed element will get
+
+    uint64_t sequenceOf(const T& element) const
+    {
+        ptrdiff_t index = &element - m_head;
+        if (index < 0)
+            index += static_cast<ptrdiff_t>(std::size(m_buffer));
+
+        assert(static_cast<size_t>(index) < size() && "element is not in the buffer");
+        return m_headSequence + static_cast<uint64_t>(index);
+    }
+
+    // throws std::out_of_range if the element has been overwritten/popped or hasn't been pushed yet
+    T&       at(uint64_t sequence)       { return *atImpl(*this, sequence); }
+    const T& at(uint64_t sequence) const { return *atImpl(*this, sequence); }
+
+    // unchecked: the element 'index' places after front(), i.e. with sequence frontSequence() + index
+    T&       operator[](size_t index)       { return *elementImpl(*this, index); }
+    const T& operator[](size_t index) const { return *elementImpl(*this, index); }
+
+    // elements starting at 'sequence', or all of them if 'sequence' has already been evicted
+    auto since(uint64_t sequence) const &
+    {
+        sequence = std::clamp(sequence, frontSequence(), endSequence());
+        return std::ranges::subrange(findNthRecent(static_cast<size_t>(endSequence() - sequence)), cend());
+    }
+
+    void since(uint64_t sequence) && = delete;                  // can't return a subrange of a temporary
+
+    // visits elements from front to back issuing a software prefetch 'prefetchDistance' elements ahead.
+    // Pays off when sizeof(T) spans several cache lines and the buffer doesn't fit into the cache,
+    // so a plain iterator walk would stall on each element
+    template <typename Function>
+    void forEachPrefetched(Function&& function, size_t prefetchDistance = k_defaultPrefetchDistance)
+    {
+        forEachPrefetchedImpl(*this, std::forward<Function>(function), prefetchDistance);
+    }
+
+    template <typename Function>
+    void forEachPrefetched(Function&& function, size_t prefetchDistance = k_defaultPrefetchDistance) const
+    {
+        forEachPrefetchedImpl(*this, std::forward<Function>(function), prefetchDistance);
+    }
+
     template <typename Convertible>
     T& pushBack(Convertible&& rvalue)
     { 
@@ -221,25 +298,282 @@ public:
         return insertedRef;
     }
 
+    // conflation of consecutive updates: merges 'value' into back() if 'sameKey(back(), value)', pushes it otherwise.
+    // 'merge(T& back, Convertible&& value)' updates the back element in place
+    template <typename Convertible, typename SameKey, typename Merge>
+    T& pushOrMerge(Convertible&& value, SameKey&& sameKey, Merge&& merge)
+    {
+        if (!empty() && sameKey(std::as_const(back()), std::as_const(value)))
+        {
+            merge(back(), std::forward<Convertible>(value));
+            return back();
+        }
+
+        return pushBack(std::forward<Convertible>(value));
+    }
+
+    // bulk pushBack: same overflow semantics, i.e. only the last capacity() values survive
+    void append(std::span<const T> values)
+    {
+        appendImpl(values, [](Pointer destination, ConstPointer source, size_t count)
+        {
+            std::copy(source, source + count, destination);
+        });
+    }
+
+    // bulk pushBack using non-temporal stores which bypass the cache: for data that is written now
+    // but read much later or by another core, so it shouldn't evict anything useful from L1/L2.
+    // Falls back to memcpy if there are no streaming stores on this platform
+    void appendStreaming(std::span<const T> values)
+    requires(std::is_trivially_copyable_v<T>)
+    {
+        appendImpl(values, [](Pointer destination, ConstPointer source, size_t count)
+        {
+            streamCopy(destination, source, count * sizeof(T));
+        });
+        storeFence();
+    }
+
+    // producer side batching: returns up to 'count' free slots after the back, without overwriting anything.
+    // Fill them in place, then publish() how many were actually written. 
+    // Slots keep their previous values, so assign rather than placement-new into them
+    SpanPair<T> claim(size_t count)
+    {
+        count = std::min(count, capacity() - size());
+
+        const size_t firstCount = std::min(count, static_cast<size_t>(bufferEnd() - m_tail));
+        return { std::span<T>(m_tail, firstCount), std::span<T>(bufferBegin(), count - firstCount) };
+    }
+
+    // makes 'count' slots of the last claim() visible as elements at the back
+    void publish(size_t count)
+    {
+        assert(count <= capacity() - size() && "publishing more than was claimed");
+
+        m_tail += static_cast<ptrdiff_t>(count);
+        if (m_tail >= bufferEnd())
+            m_tail -= std::size(m_buffer);
+    }
+
+    // consumer side batching: up to 'count' oldest elements as at most two contiguous spans.
+    // Process them in place, then release() how many were consumed
+    SpanPair<T>       peek(size_t count)       { return peekImpl(*this, count); }
+    SpanPair<const T> peek(size_t count) const { return peekImpl(*this, count); }
+
+    // pops 'count' elements from the front at once
+    void release(size_t count)
+    {
+        assert(count <= size() && "releasing more than available");
+
+        m_headSequence += count;
+        m_head += static_cast<ptrdiff_t>(count);
+        if (m_head >= bufferEnd())
+            m_head -= std::size(m_buffer);
+    }
+
     void popFront()
     {
-        if (!empty() && ++m_head == bufferEnd())
+        if (empty())
+            return;
+
+        ++m_headSequence;
+        if (++m_head == bufferEnd())
             m_head = bufferBegin();
     }
 
+    // like popFront(), the element stays in its slot until it's overwritten
+    void popBack()
+    {
+        if (empty())
+            return;
+
+        if (m_tail == bufferBegin())
+            m_tail = bufferEnd();
+        --m_tail;
+    }
+
+    // drops the elements from 'sequence' on, in O(1): the next pushBack() gets 'sequence'
+    void truncateFrom(uint64_t sequence)
+    {
+        if (sequence >= endSequence())
+            return;
+
+        assert(sequence >= frontSequence() && "truncating before the front");
+        m_tail -= static_cast<ptrdiff_t>(endSequence() - sequence);
+        if (m_tail < bufferBegin())
+            m_tail += std::size(m_buffer);
+    }
+
 private:
 
     Buffer  m_buffer;
     Pointer m_head = nullptr;      // first element
     Pointer m_tail = nullptr;      // past the last element, technically, may be before first because this is ring buffer
+    uint64_t m_headSequence = 0;   // sequence number of the first element
 
     ConstPointer bufferBegin() const { return & *std::begin(m_buffer); }
     Pointer      bufferBegin()       { return & *std::begin(m_buffer); }
     ConstPointer bufferEnd() const   { return bufferBegin() + std::size(m_buffer); }
     Pointer      bufferEnd()         { return bufferBegin() + std::size(m_buffer); }
 
+    static constexpr size_t k_defaultPrefetchDistance = 4;
+
+    static void prefetch(const void* address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0 /*read*/, 3 /*keep in all cache levels*/);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    static void prefetchElement(ConstPointer element)
+    {
+        const char* bytes = reinterpret_cast<const char*>(element);
+        for (size_t offset = 0; offset < sizeof(T); offset += detail::k_cacheLineSize)
+            prefetch(bytes + offset);
+    }
+
+    // 'Self' is either a CircularBuffer or a const CircularBuffer, so pointers get the matching constness
+    template <typename Self, typename Function>
+    static void forEachPrefetchedImpl(Self& self, Function&& function, size_t prefetchDistance)
+    {
+        auto* const first = self.bufferBegin();
+        auto* const last  = self.bufferEnd();
+        auto* const tail  = first + (self.m_tail - first);
+        auto*       current = first + (self.m_head - first);
+
+        // 'ahead' runs prefetchDistance elements before 'current' and wraps the same way
+        size_t aheadIndex = static_cast<size_t>(current - first) + std::min(prefetchDistance, self.size());
+        if (aheadIndex >= static_cast<size_t>(last - first))
+            aheadIndex -= static_cast<size_t>(last - first);
+        auto* ahead = first + aheadIndex;
+
+        while (current != tail)
+        {
+            if (ahead != tail)
+            {
+                prefetchElement(ahead);
+                if (++ahead == last)
+                    ahead = first;
+            }
+
+            function(*current);
+
+            if (++current == last)
+                current = first;
+        }
+    }
+
+    template <typename Self>
+    static auto atImpl(Self& self, uint64_t sequence)
+    {
+        if (sequence < self.frontSequence() || sequence >= self.endSequence())
+            throw std::out_of_range("CircularBuffer: sequence is not in the buffer");
+
+        return elementImpl(self, static_cast<size_t>(sequence - self.frontSequence()));
+    }
+
+    template <typename Self>
+    static auto elementImpl(Self& self, size_t offset)
+    {
+        assert(offset < self.size() && "index past the back");
+
+        auto* const first = self.bufferBegin();
+        size_t index = static_cast<size_t>(self.m_head - first) + offset;
+        if (index >= std::size(self.m_buffer))
+            index -= std::size(self.m_buffer);
+
+        return first + index;
+    }
+
+    template <typename Self>
+    static auto peekImpl(Self& self, size_t count)
+    {
+        auto* const first = self.bufferBegin();
+        auto* const head  = first + (self.m_head - first);
+        using Element     = std::remove_pointer_t<decltype(head)>;
+
+        count = std::min(count, self.size());
+
+        const size_t firstCount = std::min(count, static_cast<size_t>(self.bufferEnd() - head));
+        return SpanPair<Element>{ std::span<Element>(head, firstCount), std::span<Element>(first, count - firstCount) };
+    }
+
+    // copies into at most two contiguous segments starting at m_tail, then drops the overwritten front elements
+    template <typename CopyFunction>
+    void appendImpl(std::span<const T> values, CopyFunction&& copy)
+    {
+        const uint64_t newEndSequence = endSequence() + values.size();   // skipped values are numbered too
+
+        if (values.size() > capacity())
+            values = values.last(capacity());   // the rest would be overwritten anyway
+
+        const size_t count   = values.size();
+        const size_t newSize = std::min(size() + count, capacity());
+        m_headSequence       = newEndSequence - newSize;
+
+        const size_t firstCount = std::min(count, static_cast<size_t>(bufferEnd() - m_tail));
+        copy(m_tail, values.data(), firstCount);
+        copy(bufferBegin(), values.data() + firstCount, count - firstCount);
+
+        m_tail += static_cast<ptrdiff_t>(count);
+        if (m_tail >= bufferEnd())
+            m_tail -= std::size(m_buffer);
+
+        // tail - newSize, wrapped
+        const size_t tailIndex = static_cast<size_t>(m_tail - bufferBegin());
+        m_head = bufferBegin() + (tailIndex >= newSize ? tailIndex - newSize : tailIndex + std::size(m_buffer) - newSize);
+    }
+
+    static void streamCopy(void* destination, const void* source, size_t bytes)
+    {
+#if defined(CIRCULAR_BUFFER_HAS_SSE2)
+        char*       to   = static_cast<char*>(destination);
+        const char* from = static_cast<const char*>(source);
+
+        // streaming stores need an aligned destination: copy the unaligned prologue as usual
+        const size_t prologue = std::min(bytes, (16 - reinterpret_cast<uintptr_t>(to) % 16) % 16);
+        std::memcpy(to, from, prologue);
+        to    += prologue;
+        from  += prologue;
+        bytes -= prologue;
+
+#if defined(CIRCULAR_BUFFER_HAS_AVX)
+        if (bytes >= 32 && reinterpret_cast<uintptr_t>(to) % 32 != 0)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(to), _mm_loadu_si128(reinterpret_cast<const __m128i*>(from)));
+            to    += 16;
+            from  += 16;
+            bytes -= 16;
+        }
+
+        for (; bytes >= 32; to += 32, from += 32, bytes -= 32)
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(to), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from)));
+#endif
+
+        for (; bytes >= 16; to += 16, from += 16, bytes -= 16)
+            _mm_stream_si128(reinterpret_cast<__m128i*>(to), _mm_loadu_si128(reinterpret_cast<const __m128i*>(from)));
+
+        std::memcpy(to, from, bytes);   // epilogue
+#else
+        std::memcpy(destination, source, bytes);
+#endif
+    }
+
+    // streaming stores are weakly ordered: make them visible before anything published afterwards
+    static void storeFence()
+    {
+#if defined(CIRCULAR_BUFFER_HAS_SSE2)
+        _mm_sfence();
+#endif
+    }
+
     void shiftFront()
     {
+        ++m_headSequence;
         if (++m_head == bufferEnd())
             m_head = bufferBegin();
     }
@@ -248,9 +582,10 @@ private:
     {
         ptrdiff_t m_head = 0;
         ptrdiff_t m_tail = 0;
+        uint64_t  m_headSequence = 0;
 
         Displacements(const CircularBuffer &b)
-            : m_head(b.m_head - b.bufferBegin()), m_tail(b.m_tail - b.bufferBegin())
+            : m_head(b.m_head - b.bufferBegin()), m_tail(b.m_tail - b.bufferBegin()), m_headSequence(b.m_headSequence)
         {
         }
 
@@ -258,6 +593,7 @@ private:
         {
             b.m_head = b.bufferBegin() + m_head;
             b.m_tail = b.bufferBegin() + m_tail;
+            b.m_headSequence = m_headSequence;
         }
     };
 };
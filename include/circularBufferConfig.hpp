@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <new>          // hardware_destructive_interference_size
+
+/*
+ * Platform details shared by the headers of this library
+*/
+
+namespace detail
+{
+    // what concurrent types align their hot members to, so that threads don't false-share cache lines.
+    // GCC warns whenever std::hardware_destructive_interference_size is used in a header because its value
+    // may change with -mtune, which would silently change the layout of these types between translation units
+#if defined(__cpp_lib_hardware_interference_size) && !defined(__GNUC__)
+    inline constexpr size_t k_cacheLineSize = std::hardware_destructive_interference_size;
+#else
+    inline constexpr size_t k_cacheLineSize = 64;
+#endif
+}
+
+// SIMD paths, e.g. streaming stores in CircularBuffer and dot products in DelayLine, are compiled in when
+// the target has the instructions
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CIRCULAR_BUFFER_HAS_SSE2 1
+#include <emmintrin.h>  // __m128, _mm_stream_si128, _mm_sfence
+#endif
+
+#if defined(__AVX__)
+#define CIRCULAR_BUFFER_HAS_AVX 1
+#include <immintrin.h>  // __m256, _mm256_stream_si256
+#endif
+
+// MSVC warns (C4324) that a type was padded because of an alignment specifier, which is exactly what the
+// cache line alignment is for. Wrap the types which are, or contain, cache line aligned members
+#if defined(_MSC_VER)
+#define CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED __pragma(warning(push)) __pragma(warning(disable: 4324))
+#define CIRCULAR_BUFFER_END_CACHE_ALIGNED   __pragma(warning(pop))
+#else
+#define CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+#define CIRCULAR_BUFFER_END_CACHE_ALIGNED
+#endif
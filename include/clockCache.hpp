@@ -0,0 +1,202 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+#include "openAddressingIndex.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+// one slot of the clock
+template <typename Key, typename Value>
+struct ClockCacheEntry
+{
+    Key   m_key{};
+    Value m_value{};
+    bool  m_occupied = false;
+    mutable std::atomic<bool> m_referenced = false;    // set by concurrent readers, cleared by the hand
+};
+
+/**
+ * Fixed-capacity key/value cache with CLOCK (second chance) eviction.
+ *
+ * Entries live in a fixed circular array, one of the CircularBuffer storage backends, and an
+ * OpenAddressingIndex maps keys to their slots. A hit only sets the entry's reference bit: no list splice
+ * as in an LRU, so concurrent readers only need a shared lock. On a miss the clock hand sweeps
+ * the ring, clearing reference bits, until it reaches an entry which wasn't referenced since the last
+ * sweep, and the new entry takes its slot. Every entry is passed over at most once, so misses are O(1)
+ * amortized.
+ *
+ * Like in CircularBuffer the storage backend has one more slot than the capacity, which isn't used here.
+ */
+template <typename Key, typename Value, typename Buffer = VectorBuffer<ClockCacheEntry<Key, Value>>>
+class ClockCache
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    struct PrivateDummy;
+
+public:
+
+    using Entry = ClockCacheEntry<Key, Value>;
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    explicit ClockCache(SizeType capacity)
+        : m_entries(capacity)
+        , m_index  (static_cast<size_t>(capacity))
+    {
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    ClockCache()
+        : m_entries()
+        , m_index  (std::size(m_entries) - 1)
+    {
+    }
+
+    ClockCache(const ClockCache&)            = delete;    // entries hold atomics
+    ClockCache& operator=(const ClockCache&) = delete;
+
+    size_t size() const     { return m_index.size(); }
+    size_t capacity() const { return std::size(m_entries) - 1; }   // minus the unused sentinel
+    bool   empty() const    { return size() == 0; }
+
+    // nullptr on a miss; a hit marks the entry as recently used.
+    // The const overload may run concurrently with other const calls: see ConcurrentClockCache
+    Value* find(const Key& key)
+    {
+        return const_cast<Value*>(std::as_const(*this).find(key));
+    }
+
+    const Value* find(const Key& key) const
+    {
+        const uint32_t* slot = m_index.find(key, [this](uint32_t slot) -> const Key& { return entryAt(slot).m_key; });
+        if (!slot)
+            return nullptr;
+
+        const Entry& entry = entryAt(*slot);
+        // a plain load first: hot entries are already marked and the cache line stays shared between readers
+        if (!entry.m_referenced.load(std::memory_order_relaxed))
+            entry.m_referenced.store(true, std::memory_order_relaxed);
+        return &entry.m_value;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return m_index.find(key, [this](uint32_t slot) -> const Key& { return entryAt(slot).m_key; }) != nullptr;
+    }
+
+    // inserts or overwrites the value of 'key', evicting the first entry the hand finds unreferenced if full
+    template <typename Convertible>
+    Value& insertOrAssign(const Key& key, Convertible&& value)
+    {
+        if (Value* existing = find(key))
+        {
+            *existing = std::forward<Convertible>(value);
+            return *existing;
+        }
+
+        const uint32_t slot  = victim();
+        Entry&         entry = entryAt(slot);
+        if (entry.m_occupied)
+            m_index.erase(entry.m_key, slot);
+
+        entry.m_key      = key;
+        entry.m_value    = std::forward<Convertible>(value);
+        entry.m_occupied = true;
+        entry.m_referenced.store(false, std::memory_order_relaxed);   // new entries have to earn their second chance
+        m_index.insert(key, slot);
+        return entry.m_value;
+    }
+
+    bool erase(const Key& key)
+    {
+        const uint32_t* slot = m_index.find(key, [this](uint32_t slot) -> const Key& { return entryAt(slot).m_key; });
+        if (!slot)
+            return false;
+
+        const uint32_t erased = *slot;
+        m_index.erase(key, erased);
+        entryAt(erased).m_occupied = false;   // the hand will reuse it without a sweep
+        return true;
+    }
+
+private:
+
+    Buffer                               m_entries;
+    OpenAddressingIndex<Key, uint32_t>   m_index;
+    uint32_t                             m_hand = 0;
+
+    Entry&       entryAt(uint32_t slot)       { return *(std::begin(m_entries) + slot); }
+    const Entry& entryAt(uint32_t slot) const { return *(std::begin(m_entries) + slot); }
+
+    // sweeps the hand to a free or unreferenced entry: terminates within one turn plus one, since it clears what it passes
+    uint32_t victim()
+    {
+        assert(capacity() > 0);
+        for (;;)
+        {
+            const uint32_t slot  = m_hand;
+            Entry&         entry = entryAt(slot);
+            if (++m_hand == capacity())
+                m_hand = 0;
+
+            if (!entry.m_occupied || !entry.m_referenced.exchange(false, std::memory_order_relaxed))
+                return slot;
+        }
+    }
+};
+
+/**
+ * ClockCache for many reader threads and occasional writers. Readers share the lock: a hit just sets an
+ * atomic reference bit, so concurrent hits don't serialize. Inserts and erases take the lock exclusively.
+ * Values are returned by copy, because an entry may be evicted as soon as the lock is released.
+ */
+template <typename Key, typename Value>
+class ConcurrentClockCache
+{
+public:
+
+    explicit ConcurrentClockCache(size_t capacity)
+        : m_cache(capacity)
+    {
+    }
+
+    size_t capacity() const { return m_cache.capacity(); }
+
+    size_t size() const
+    {
+        std::shared_lock lock(m_mutex);
+        return m_cache.size();
+    }
+
+    std::optional<Value> find(const Key& key) const
+    {
+        std::shared_lock lock(m_mutex);
+        const Value* value = m_cache.find(key);
+        return value ? std::optional<Value>(*value) : std::nullopt;
+    }
+
+    template <typename Convertible>
+    void insertOrAssign(const Key& key, Convertible&& value)
+    {
+        std::unique_lock lock(m_mutex);
+        m_cache.insertOrAssign(key, std::forward<Convertible>(value));
+    }
+
+    bool erase(const Key& key)
+    {
+        std::unique_lock lock(m_mutex);
+        return m_cache.erase(key);
+    }
+
+private:
+
+    ClockCache<Key, Value>    m_cache;
+    mutable std::shared_mutex m_mutex;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+#include "openAddressingIndex.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Queue of updates conflated per key, e.g. the latest quote per symbol: a consumer which falls behind sees
+ * only the freshest update of each key instead of every intermediate one.
+ *
+ * Updates are kept in a CircularBuffer in the order their key first became pending. An OpenAddressingIndex
+ * maps each pending key to the sequence number of its update, so an update of a pending key is merged into
+ * that element in place, wherever it is in the ring; only updates of new keys take a slot. Occupancy is
+ * bounded by the number of distinct keys rather than by the update rate.
+ *
+ * When only consecutive updates of the same key need conflating, CircularBuffer::pushOrMerge() does it
+ * without an index. Like there, a full queue overwrites its oldest update.
+ */
+template <typename T, typename KeyOf, typename Buffer = VectorBuffer<T>>
+class ConflatingQueue
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    struct PrivateDummy;
+
+public:
+
+    using Key = std::remove_cvref_t<std::invoke_result_t<KeyOf, const T&>>;
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    explicit ConflatingQueue(SizeType capacity, KeyOf keyOf = KeyOf())
+        : m_updates(capacity)
+        , m_index  (static_cast<size_t>(capacity))
+        , m_keyOf  (std::move(keyOf))
+    {
+        assert(m_updates.capacity() < (uint64_t(1) << 32) && "sequence numbers are truncated to 32 bits in the index");
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    explicit ConflatingQueue(KeyOf keyOf = KeyOf())
+        : m_updates()
+        , m_index  (m_updates.capacity())
+        , m_keyOf  (std::move(keyOf))
+    {
+    }
+
+    ConflatingQueue(const ConflatingQueue&)            = delete;
+    ConflatingQueue& operator=(const ConflatingQueue&) = delete;
+
+    size_t   size() const      { return m_updates.size(); }
+    size_t   capacity() const  { return m_updates.capacity(); }
+    bool     empty() const     { return m_updates.empty(); }
+    uint64_t conflated() const { return m_conflated; }      // updates merged into a pending one so far
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    // the latest value replaces the pending one
+    template <typename Convertible>
+    void push(Convertible&& value)
+    {
+        push(std::forward<Convertible>(value), [](T& pending, auto&& update) { pending = std::forward<decltype(update)>(update); });
+    }
+
+    // 'merge(T& pending, Convertible&& update)' folds the update into the pending element of the same key,
+    // e.g. to keep the latest price but accumulate traded volume
+    template <typename Convertible, typename Merge>
+    void push(Convertible&& value, Merge&& merge)
+    {
+        const Key key = m_keyOf(std::as_const(value));
+        if (const uint32_t* truncatedSequence = find(key))
+        {
+            merge(updateAt(*truncatedSequence), std::forward<Convertible>(value));
+            assert(m_keyOf(std::as_const(updateAt(*truncatedSequence))) == key && "merge() must not change the key");
+            ++m_conflated;
+            return;
+        }
+
+        if (m_updates.size() == m_updates.capacity())
+            popFront();     // the index has to forget the update which is about to be overwritten
+
+        const uint64_t sequence = m_updates.endSequence();
+        m_updates.pushBack(std::forward<Convertible>(value));
+        m_index.insert(key, static_cast<uint32_t>(sequence));
+    }
+
+    // the oldest pending update
+    const T& front() const { return m_updates.front(); }
+
+    void popFront()
+    {
+        assert(!empty());
+        m_index.erase(m_keyOf(m_updates.front()), static_cast<uint32_t>(m_updates.frontSequence()));
+        m_updates.popFront();
+    }
+
+    // pending updates in queue order
+    const CircularBuffer<T, Buffer>& updates() const { return m_updates; }
+
+private:
+
+    CircularBuffer<T, Buffer>           m_updates;
+    OpenAddressingIndex<Key, uint32_t>  m_index;
+    KeyOf                               m_keyOf;
+    uint64_t                            m_conflated = 0;
+
+    const uint32_t* find(const Key& key) const
+    {
+        return m_index.find(key, [this](uint32_t truncatedSequence) -> decltype(auto) { return m_keyOf(updateAt(truncatedSequence)); });
+    }
+
+    const T& updateAt(uint32_t truncatedSequence) const { return detail::atTruncatedSequence(m_updates, truncatedSequence); }
+    T&       updateAt(uint32_t truncatedSequence)       { return detail::atTruncatedSequence(m_updates, truncatedSequence); }
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+#include "openAddressingIndex.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+
+/**
+ * "Seen in the last N" de-duplication: the last 'capacity' distinct keys in arrival order, with O(1) contains().
+ *
+ * Keys are kept in a CircularBuffer and an OpenAddressingIndex over the ring contents maps each key to its
+ * sequence number. The index follows every change of the ring: pushBack() indexes the new key and un-indexes
+ * the one it overwrites, popFront() un-indexes the front. Nothing is allocated after the constructor.
+ *
+ * The index stores only the low 32 bits of a sequence number: the ring holds less than 2^32 elements, so
+ * they identify the element uniquely and the full number is recovered relative to frontSequence().
+ */
+template <typename Key, typename Buffer = VectorBuffer<Key>, typename Hash = std::hash<Key>>
+class DedupWindow
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    struct PrivateDummy;
+
+public:
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    explicit DedupWindow(SizeType capacity)
+        : m_keys (capacity)
+        , m_index(static_cast<size_t>(capacity))
+    {
+        assert(m_keys.capacity() < (uint64_t(1) << 32) && "sequence numbers are truncated to 32 bits in the index");
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    DedupWindow()
+        : m_keys ()
+        , m_index(m_keys.capacity())
+    {
+    }
+
+    DedupWindow(const DedupWindow&)            = delete;
+    DedupWindow& operator=(const DedupWindow&) = delete;
+
+    size_t size() const     { return m_keys.size(); }
+    size_t capacity() const { return m_keys.capacity(); }
+    bool   empty() const    { return m_keys.empty(); }
+
+    bool contains(const Key& key) const
+    {
+        return m_index.find(key, [this](uint32_t sequence) -> const Key& { return keyAt(sequence); }) != nullptr;
+    }
+
+    // pushes the key unless it's already in the window: returns false for a duplicate, which isn't pushed.
+    // When full the oldest key is evicted, i.e. forgotten
+    bool pushBack(const Key& key)
+    {
+        if (contains(key))
+            return false;
+
+        if (m_keys.size() == m_keys.capacity())
+            popFront();     // CircularBuffer would overwrite it, but the index has to forget it first
+
+        const uint64_t sequence = m_keys.endSequence();
+        m_keys.pushBack(key);
+        m_index.insert(key, static_cast<uint32_t>(sequence));
+        return true;
+    }
+
+    void popFront()
+    {
+        assert(!empty());
+        m_index.erase(m_keys.front(), static_cast<uint32_t>(m_keys.frontSequence()));
+        m_keys.popFront();
+    }
+
+    void clear()
+    {
+        while (!empty())
+            m_keys.popFront();
+        m_index.clear();
+    }
+
+    // the keys, oldest first
+    const CircularBuffer<Key, Buffer>& keys() const { return m_keys; }
+
+private:
+
+    CircularBuffer<Key, Buffer>              m_keys;
+    OpenAddressingIndex<Key, uint32_t, Hash> m_index;
+
+    const Key& keyAt(uint32_t truncatedSequence) const
+    {
+        return detail::atTruncatedSequence(m_keys, truncatedSequence);
+    }
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "circularBufferConfig.hpp"   // SIMD feature macros
+
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Delay line for audio and sensor processing: the last 'length' samples with integer and fractional taps.
+ *
+ * Unlike CircularBuffer, the history is mirrored: each sample is written twice, at 'position' and
+ * 'position + length', so the most recent 'length' samples always form one contiguous span. That costs one
+ * extra store per sample but lets filters run straight SIMD loops without splitting work at the wrap.
+ */
+template <typename Sample = float>
+class DelayLine
+{
+    static_assert(std::is_floating_point_v<Sample>);
+
+public:
+
+    explicit DelayLine(size_t length)
+        : m_length(length)
+        , m_history(2 * length, Sample(0))
+    {
+        assert(length > 0);
+    }
+
+    size_t length() const { return m_length; }
+
+    void push(Sample sample)
+    {
+        m_history[m_position]            = sample;
+        m_history[m_position + m_length] = sample;
+        if (++m_position == m_length)
+            m_position = 0;
+    }
+
+    void push(std::span<const Sample> samples)
+    {
+        for (Sample sample : samples)
+            push(sample);
+    }
+
+    // the last length() samples, oldest first
+    std::span<const Sample> recent() const { return std::span<const Sample>(m_history).subspan(m_position, m_length); }
+
+    // delay 0 is the most recent sample
+    Sample tap(size_t delay) const
+    {
+        assert(delay < m_length);
+        return m_history[m_position + m_length - 1 - delay];
+    }
+
+    // fractional delay, linear interpolation: 0 <= delay <= length() - 1
+    Sample tapLinear(Sample delay) const
+    {
+        assert(delay >= 0 && delay <= Sample(m_length - 1));
+        const size_t whole    = static_cast<size_t>(delay);
+        const Sample fraction = delay - Sample(whole);
+
+        const Sample near = tap(whole);
+        const Sample far  = whole + 1 < m_length ? tap(whole + 1) : near;
+        return near + fraction * (far - near);
+    }
+
+    // fractional delay, 4-point cubic Hermite (Catmull-Rom) interpolation: 1 <= delay <= length() - 3
+    Sample tapCubic(Sample delay) const
+    {
+        assert(delay >= 1 && delay <= Sample(m_length) - 3);
+        const size_t whole = static_cast<size_t>(delay);
+        const Sample t     = delay - Sample(whole);
+
+        const Sample y0 = tap(whole - 1);
+        const Sample y1 = tap(whole);
+        const Sample y2 = tap(whole + 1);
+        const Sample y3 = tap(whole + 2);
+
+        const Sample c1 = Sample(0.5) * (y2 - y0);
+        const Sample c2 = y0 - Sample(2.5) * y1 + Sample(2) * y2 - Sample(0.5) * y3;
+        const Sample c3 = Sample(0.5) * (y3 - y0) + Sample(1.5) * (y1 - y2);
+        return ((c3 * t + c2) * t + c1) * t + y1;
+    }
+
+private:
+
+    size_t              m_length;
+    std::vector<Sample> m_history;      // 2 * length: mirrored
+    size_t              m_position = 0; // where the next sample goes
+};
+
+namespace detail
+{
+    // sum of left[i] * right[i], vectorized for float when SSE/AVX is available
+    template <typename Sample>
+    Sample dotProduct(const Sample* left, const Sample* right, size_t count)
+    {
+        Sample sum = 0;
+        size_t i = 0;
+
+        if constexpr (std::is_same_v<Sample, float>)
+        {
+#if defined(CIRCULAR_BUFFER_HAS_AVX)
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+            for (; i + 16 <= count; i += 16)
+            {
+                acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(left + i),     _mm256_loadu_ps(right + i)));
+                acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(left + i + 8), _mm256_loadu_ps(right + i + 8)));
+            }
+
+            alignas(32) float lanes[8];
+            _mm256_store_ps(lanes, _mm256_add_ps(acc0, acc1));
+            for (float lane : lanes)
+                sum += lane;
+#elif defined(CIRCULAR_BUFFER_HAS_SSE2)
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            for (; i + 8 <= count; i += 8)
+            {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(left + i),     _mm_loadu_ps(right + i)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(left + i + 4), _mm_loadu_ps(right + i + 4)));
+            }
+
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+            for (float lane : lanes)
+                sum += lane;
+#endif
+        }
+
+        // not 'for (; i < count; ++i)': inlined into Resampler::process(), GCC 12.2 at -O2 reports a false positive
+        // "iteration 4611686018427387903 invokes undefined behavior [-Werror=aggressive-loop-optimizations]"
+        for (const Sample* end = left + count; left + i != end; ++i)
+            sum += left[i] * right[i];
+
+        return sum;
+    }
+}
+
+/**
+ * FIR filter: y[n] = sum of h[k] * x[n - k]. The history is a DelayLine as long as the filter, so each
+ * output is a single contiguous dot product of the reversed coefficients with the recent samples.
+ */
+template <typename Sample = float>
+class FirFilter
+{
+public:
+
+    explicit FirFilter(std::span<const Sample> coefficients)
+        : m_reversed(coefficients.rbegin(), coefficients.rend())
+        , m_history(coefficients.size())
+    {
+    }
+
+    size_t taps() const { return m_reversed.size(); }
+
+    Sample process(Sample input)
+    {
+        m_history.push(input);
+        return detail::dotProduct(m_reversed.data(), m_history.recent().data(), m_reversed.size());
+    }
+
+    void process(std::span<const Sample> input, std::span<Sample> output)
+    {
+        assert(output.size() >= input.size());
+        for (size_t i = 0; i < input.size(); ++i)
+            output[i] = process(input[i]);
+    }
+
+private:
+
+    std::vector<Sample> m_reversed;     // h[taps - 1] ... h[0], lined up with the oldest-first history
+    DelayLine<Sample>   m_history;
+};
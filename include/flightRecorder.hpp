@@ -0,0 +1,206 @@
+#pragma once
+
+#include "broadcastRing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <algorithm>  // min, find_if, stable_sort
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Per-thread flight recorder for post-mortem debugging.
+ *
+ * Each thread records into its own thread-local BroadcastRing, so recording is a timestamp and a pushBack
+ * into per-slot seqlocks, with no shared writes at all. A global registry keeps every ring alive, including
+ * rings of threads which have already finished, and dump() reads them all and k-way merges them by timestamp
+ * into one chronological trace. A new thread takes over the ring of a finished one, if there is any, and
+ * records after its events, so the registry holds no more rings than there were threads alive at once.
+ *
+ * dump() may run while the threads keep recording: it reads each ring like a BroadcastRing reader, so every
+ * event it returns was validated by its slot stamp, and events overwritten during the read are skipped, never
+ * returned torn. dump() allocates and takes a mutex, so call it from an API call or a crash handler which can
+ * afford that, not from an async signal handler.
+ *
+ * 'Capacity' is rounded up to a power of two. 'Tag' separates independent recorders which happen to have the
+ * same payload and capacity.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename Payload = uint64_t, size_t Capacity = 1024, typename Tag = void, typename Clock = std::chrono::steady_clock>
+class FlightRecorder
+{
+public:
+
+    struct Event
+    {
+        uint64_t m_timestamp = 0;    // Clock ticks
+        uint32_t m_thread    = 0;    // registration order of the recording thread
+        uint32_t m_id        = 0;    // what happened, user-defined
+        Payload  m_payload   = {};
+    };
+
+    static_assert(std::is_trivially_copyable_v<Payload>, "events are copied while they may be overwritten");
+
+    FlightRecorder() = delete;
+
+    static void record(uint32_t id, const Payload& payload = {})
+    {
+        recordAt(static_cast<uint64_t>(Clock::now().time_since_epoch().count()), id, payload);
+    }
+
+    static void recordAt(uint64_t timestamp, uint32_t id, const Payload& payload = {})
+    {
+        ThreadRing& ring = threadRing();
+        ring.m_events.pushBack(Event{ timestamp, ring.m_thread, id, payload });
+    }
+
+    // all rings merged in timestamp order; events of the same thread keep their recording order
+    static std::vector<Event> dump()
+    {
+        std::vector<Snapshot> snapshots = snapshotAll();
+
+        size_t total = 0;
+        for (const Snapshot& snapshot : snapshots)
+            total += snapshot.size();
+
+        std::vector<Event> merged;
+        merged.reserve(total);
+
+        // k-way merge of the snapshots sorted by time: a thread records in time order, so only a ring taken over
+        // from a finished thread with recordAt() may need the sort, over all of its events
+        auto earlier = [](const Event& left, const Event& right) { return left.m_timestamp < right.m_timestamp; };
+        for (Snapshot& snapshot : snapshots)
+            if (!std::is_sorted(snapshot.begin(), snapshot.end(), earlier))
+                std::stable_sort(snapshot.begin(), snapshot.end(), earlier);
+
+        using Cursor = std::pair<typename Snapshot::const_iterator, typename Snapshot::const_iterator>;
+        auto later = [](const Cursor& left, const Cursor& right)
+        {
+            return left.first->m_timestamp != right.first->m_timestamp
+                ? left.first->m_timestamp > right.first->m_timestamp
+                : left.first->m_thread > right.first->m_thread;
+        };
+
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(later);
+        for (const Snapshot& snapshot : snapshots)
+            if (!snapshot.empty())
+                heap.emplace(snapshot.cbegin(), snapshot.cend());
+
+        while (!heap.empty())
+        {
+            Cursor cursor = heap.top();
+            heap.pop();
+
+            merged.push_back(*cursor.first);
+            if (++cursor.first != cursor.second)
+                heap.push(cursor);
+        }
+
+        return merged;
+    }
+
+    // forgets everything recorded so far; events recorded concurrently may or may not be forgotten
+    static void clear()
+    {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.m_mutex);
+
+        for (const std::shared_ptr<ThreadRing>& ring : registry.m_rings)
+            ring->m_clearedEnd.store(ring->m_events.endSequence(), std::memory_order_relaxed);
+    }
+
+private:
+
+    using Snapshot = std::vector<Event>;
+
+    struct ThreadRing
+    {
+        BroadcastRing<Event>  m_events { Capacity };
+        uint32_t              m_thread     = 0;
+        std::atomic<uint64_t> m_clearedEnd = 0;      // events before this sequence were clear()ed
+        std::atomic<bool>     m_owned      = true;   // false once the recording thread has finished
+    };
+
+    // the thread's hold on its ring: gives the ring back to the registry when the thread finishes
+    struct ThreadOwner
+    {
+        std::shared_ptr<ThreadRing> m_ring;
+
+        ~ThreadOwner() { m_ring->m_owned.store(false, std::memory_order_release); }
+    };
+
+    struct Registry
+    {
+        std::mutex                               m_mutex;
+        std::vector<std::shared_ptr<ThreadRing>> m_rings;     // shared: outlives the threads for the post-mortem
+        uint32_t                                 m_threads = 0;
+    };
+
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static ThreadRing& threadRing()
+    {
+        thread_local ThreadOwner t_owner{ registerThread() };
+        return *t_owner.m_ring;
+    }
+
+    static std::shared_ptr<ThreadRing> registerThread()
+    {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.m_mutex);
+
+        // acquire: the finished thread's last pushBack() happens before this thread's first one
+        auto finished = std::find_if(registry.m_rings.begin(), registry.m_rings.end(),
+            [](const std::shared_ptr<ThreadRing>& ring) { return !ring->m_owned.load(std::memory_order_acquire); });
+
+        std::shared_ptr<ThreadRing> ring;
+        if (finished != registry.m_rings.end())
+        {
+            ring = *finished;
+            ring->m_owned.store(true, std::memory_order_relaxed);
+        }
+        else
+        {
+            ring = registry.m_rings.emplace_back(std::make_shared<ThreadRing>());
+        }
+
+        ring->m_thread = registry.m_threads++;
+        return ring;
+    }
+
+    static std::vector<Snapshot> snapshotAll()
+    {
+        Registry& registry = instance();
+        std::lock_guard lock(registry.m_mutex);
+
+        std::vector<Snapshot> snapshots;
+        snapshots.reserve(registry.m_rings.size());
+
+        for (const std::shared_ptr<ThreadRing>& ring : registry.m_rings)
+        {
+            // up to what was recorded when the read started: a busy thread can't keep the dump going forever
+            const uint64_t end = ring->m_events.endSequence();
+            typename BroadcastRing<Event>::Reader reader = ring->m_events.makeReaderFromOldest();
+            const uint64_t cleared = ring->m_clearedEnd.load(std::memory_order_relaxed);
+
+            Snapshot& snapshot = snapshots.emplace_back();
+            snapshot.reserve(static_cast<size_t>(std::min<uint64_t>(end, ring->m_events.capacity())));
+
+            Event event;
+            while (reader.position() < end && reader.tryRead(event))
+                if (reader.position() > cleared)    // position() is already past the event
+                    snapshot.push_back(event);
+        }
+
+        return snapshots;
+    }
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+#include "boundedQueue.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+/**
+ * Pools of pre-constructed heavy objects (messages with strings and vectors inside) recycled instead of
+ * allocated and freed. The free list is a ring of pointers: acquire() pops its front and release() pushes
+ * to its back, so objects are reused round-robin and keep their capacity across reuse.
+ * It's up to the user to reset the object state (e.g. clear() containers) after acquire() or before release().
+ *
+ * ObjectPool is single-threaded and has its free list in a CircularBuffer. ConcurrentObjectPool is the
+ * lock-free variant for objects released on other threads, with the free list in a BoundedQueue.
+ * Both keep an in-use flag per object: releasing an object which isn't in use asserts, and is ignored in release
+ * builds, so that it can't be handed out twice.
+ */
+
+// unique_ptr deleter which returns the object to its pool
+template <typename Pool>
+struct PoolReleaser
+{
+    Pool* m_pool = nullptr;
+
+    template <typename T>
+    void operator()(T* object) const { m_pool->release(object); }
+};
+
+template <typename T, typename Buffer = VectorBuffer<T*>>
+class ObjectPool
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    struct PrivateDummy;
+
+public:
+
+    using Handle = std::unique_ptr<T, PoolReleaser<ObjectPool>>;
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    explicit ObjectPool(SizeType count)
+        : m_free(count)
+    {
+        fill();
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    ObjectPool()
+    {
+        fill();
+    }
+
+    ObjectPool(const ObjectPool&)            = delete;   // the free list points into m_objects
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    size_t capacity() const  { return m_free.capacity(); }
+    size_t available() const { return m_free.size(); }
+
+    // nullptr if every object is in use
+    T* acquire()
+    {
+        if (m_free.empty())
+            return nullptr;
+
+        T* object = m_free.front();
+        m_free.popFront();
+        m_inUse[indexOf(object)] = true;
+        return object;
+    }
+
+    void release(T* object)
+    {
+        assert(owns(object) && "the object is not from this pool");
+        bool& inUse = m_inUse[indexOf(object)];
+        assert(inUse && "double release");
+        if (!inUse)
+            return;
+
+        inUse = false;
+        m_free.pushBack(object);
+    }
+
+    // releases automatically when the handle goes out of scope
+    Handle acquireScoped() { return Handle(acquire(), PoolReleaser<ObjectPool>{ this }); }
+
+    bool owns(const T* object) const { return object >= m_objects.get() && object < m_objects.get() + capacity(); }
+
+private:
+
+    CircularBuffer<T*, Buffer> m_free;
+    std::unique_ptr<T[]>       m_objects;
+    std::unique_ptr<bool[]>    m_inUse;
+
+    size_t indexOf(const T* object) const { return static_cast<size_t>(object - m_objects.get()); }
+
+    void fill()
+    {
+        m_objects = std::make_unique<T[]>(m_free.capacity());
+        m_inUse   = std::make_unique<bool[]>(m_free.capacity());
+        for (size_t i = 0; i < m_free.capacity(); ++i)
+            m_free.pushBack(&m_objects[i]);
+    }
+};
+
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename T>
+class ConcurrentObjectPool
+{
+public:
+
+    using Handle = std::unique_ptr<T, PoolReleaser<ConcurrentObjectPool>>;
+
+    // count is rounded up to a power of two
+    explicit ConcurrentObjectPool(size_t count)
+        : m_free(count)
+        , m_objects(std::make_unique<T[]>(m_free.capacity()))
+        , m_inUse  (std::make_unique<std::atomic<bool>[]>(m_free.capacity()))
+    {
+        for (size_t i = 0; i < m_free.capacity(); ++i)
+            m_free.tryPush(&m_objects[i]);
+    }
+
+    ConcurrentObjectPool(const ConcurrentObjectPool&)            = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+    size_t capacity() const  { return m_free.capacity(); }
+    size_t available() const { return m_free.size(); }    // approximate when called concurrently
+
+    // any thread; nullptr if every object is in use
+    T* acquire()
+    {
+        T* object = nullptr;
+        if (!m_free.tryPop(object))
+            return nullptr;
+
+        m_inUse[indexOf(object)].store(true, std::memory_order_relaxed);
+        return object;
+    }
+
+    // any thread
+    void release(T* object)
+    {
+        assert(owns(object) && "the object is not from this pool");
+
+        // the exchange lets only one of two racing releases through; the queue orders it with the next acquire()
+        const bool wasInUse = m_inUse[indexOf(object)].exchange(false, std::memory_order_relaxed);
+        assert(wasInUse && "double release");
+        if (!wasInUse)
+            return;
+
+        [[maybe_unused]] bool pushed = m_free.tryPush(object);
+        assert(pushed && "the free list holds every object");
+    }
+
+    Handle acquireScoped() { return Handle(acquire(), PoolReleaser<ConcurrentObjectPool>{ this }); }
+
+    bool owns(const T* object) const { return object >= m_objects.get() && object < m_objects.get() + capacity(); }
+
+private:
+
+    BoundedQueue<T*>                     m_free;
+    std::unique_ptr<T[]>                 m_objects;
+    std::unique_ptr<std::atomic<bool>[]> m_inUse;
+
+    size_t indexOf(const T* object) const { return static_cast<size_t>(object - m_objects.get()); }
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>  // max
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>    // as_const
+#include <vector>
+
+/**
+ * Fixed-size hash index from keys to small values (slot numbers, sequence numbers) which points into
+ * storage owned by someone else, e.g. the elements of a ring.
+ *
+ * The index doesn't keep the keys: find() is given a 'keyOf(value)' function which fetches the key from the
+ * indexed storage, and a 32 bit hash kept next to each value filters out almost every mismatch before it.
+ * The table is a single allocation made by the constructor, at least twice as large as 'maxEntries'.
+ * Linear probing with backward-shift erase leaves no tombstones, so lookups don't degrade under churn.
+ */
+template <typename Key, typename Value = uint32_t, typename Hash = std::hash<Key>>
+class OpenAddressingIndex
+{
+public:
+
+    explicit OpenAddressingIndex(size_t maxEntries)
+        : m_slots(std::bit_ceil(std::max<size_t>(2 * maxEntries, 2)))
+        , m_mask (m_slots.size() - 1)
+        , m_maxEntries(maxEntries)
+    {
+        assert(m_slots.size() <= (size_t(1) << 31) && "the hash has to cover the whole table");
+    }
+
+    size_t size() const       { return m_size; }
+    size_t maxEntries() const { return m_maxEntries; }
+    bool   empty() const      { return m_size == 0; }
+
+    template <typename KeyOf>
+    Value* find(const Key& key, KeyOf&& keyOf)
+    {
+        return const_cast<Value*>(std::as_const(*this).find(key, keyOf));
+    }
+
+    // nullptr if the key isn't indexed
+    template <typename KeyOf>
+    const Value* find(const Key& key, KeyOf&& keyOf) const
+    {
+        const uint32_t hash = hashOf(key);
+        for (size_t position = hash & m_mask; m_slots[position].m_hash != k_empty; position = (position + 1) & m_mask)
+        {
+            const Slot& slot = m_slots[position];
+            if (slot.m_hash == hash && keyOf(slot.m_value) == key)
+                return &slot.m_value;
+        }
+        return nullptr;
+    }
+
+    // the key must not be indexed yet
+    void insert(const Key& key, Value value)
+    {
+        assert(m_size < m_maxEntries && "the index is full");
+
+        const uint32_t hash = hashOf(key);
+        size_t position = hash & m_mask;
+        while (m_slots[position].m_hash != k_empty)
+            position = (position + 1) & m_mask;
+
+        m_slots[position] = Slot{ hash, value };
+        ++m_size;
+    }
+
+    // removes the entry of 'key' which has 'value', doesn't need to look at the indexed storage
+    bool erase(const Key& key, const Value& value)
+    {
+        const uint32_t hash = hashOf(key);
+        for (size_t position = hash & m_mask; m_slots[position].m_hash != k_empty; position = (position + 1) & m_mask)
+        {
+            if (m_slots[position].m_hash == hash && m_slots[position].m_value == value)
+            {
+                eraseAt(position);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        for (Slot& slot : m_slots)
+            slot.m_hash = k_empty;
+        m_size = 0;
+    }
+
+private:
+
+    static constexpr uint32_t k_empty = 0;
+
+    struct Slot
+    {
+        uint32_t m_hash = k_empty;
+        Value    m_value{};
+    };
+
+    std::vector<Slot> m_slots;
+    size_t            m_mask;
+    size_t            m_maxEntries;
+    size_t            m_size = 0;
+
+    static uint32_t hashOf(const Key& key)
+    {
+        // std::hash of integers is the identity in the common implementations: mix it before masking
+        const uint64_t mixed = static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+        const uint32_t hash  = static_cast<uint32_t>(mixed >> 32);
+        return hash == k_empty ? 1 : hash;
+    }
+
+    // backward-shift: pulls the following entries of the probe run into the hole so that no tombstone is needed
+    void eraseAt(size_t hole)
+    {
+        for (size_t position = (hole + 1) & m_mask; m_slots[position].m_hash != k_empty; position = (position + 1) & m_mask)
+        {
+            const size_t home = m_slots[position].m_hash & m_mask;
+            // the entry may move into the hole only if the hole is on its probe path: home <= hole < position, cyclically
+            if (((position - home) & m_mask) >= ((position - hole) & m_mask))
+            {
+                m_slots[hole] = m_slots[position];
+                hole = position;
+            }
+        }
+
+        m_slots[hole].m_hash = k_empty;
+        --m_size;
+    }
+};
+
+namespace detail
+{
+    // indexes into a ring keep the low 32 bits of sequence numbers. The ring holds fewer than 2^32 elements,
+    // so the distance from its front computed in 32 bits wraps around like the sequence and is exact
+    template <typename Ring>
+    decltype(auto) atTruncatedSequence(Ring& ring, uint32_t truncatedSequence)
+    {
+        return ring[truncatedSequence - static_cast<uint32_t>(ring.frontSequence())];
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+#include "delayLine.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <vector>
+
+/**
+ * Streaming polyphase resampler by a rational factor L/M: conceptually upsample by L, low-pass, keep every
+ * M-th sample, but only the outputs which are kept get computed and only the non-zero inputs are touched.
+ * The prototype filter of length L * tapsPerPhase is split into L phases of tapsPerPhase taps each.
+ *
+ * The filter state is a DelayLine of tapsPerPhase input samples, so the resampler runs indefinitely without
+ * reallocation. Feed it blocks of any size: spans, or straight from one CircularBuffer into another.
+ * A decimator is the L == 1 case.
+ */
+template <typename Sample = float>
+class Resampler
+{
+public:
+
+    // windowed-sinc (Blackman) low-pass for the L/M conversion, with the gain of L to make up for the zero stuffing
+    static std::vector<Sample> designLowPass(size_t upFactor, size_t downFactor, size_t tapsPerPhase)
+    {
+        const size_t length = upFactor * tapsPerPhase;
+        const double cutoff = 0.5 / static_cast<double>(std::max(upFactor, downFactor));   // of the upsampled rate
+        const double middle = static_cast<double>(length - 1) / 2;
+
+        std::vector<double> prototype(length);
+        double sum = 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+            const double x      = static_cast<double>(i) - middle;
+            const double sinc   = x == 0 ? 2 * cutoff : std::sin(2 * std::numbers::pi * cutoff * x) / (std::numbers::pi * x);
+            const double phase  = length > 1 ? 2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(length - 1) : std::numbers::pi;
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2 * phase);     // 1 in the middle
+            prototype[i] = sinc * window;
+            sum += prototype[i];
+        }
+
+        // exact DC gain of L, however short the filter is
+        std::vector<Sample> coefficients(length);
+        for (size_t i = 0; i < length; ++i)
+            coefficients[i] = static_cast<Sample>(prototype[i] * static_cast<double>(upFactor) / sum);
+
+        return coefficients;
+    }
+
+    Resampler(size_t upFactor, size_t downFactor, size_t tapsPerPhase = 16)
+        : Resampler(upFactor, downFactor, designLowPass(upFactor, downFactor, tapsPerPhase))
+    {
+    }
+
+    // 'prototype' is the filter at the upsampled rate, its length is rounded up to a multiple of upFactor with zeros
+    Resampler(size_t upFactor, size_t downFactor, std::span<const Sample> prototype)
+        : m_up(upFactor)
+        , m_down(downFactor)
+        , m_tapsPerPhase((prototype.size() + upFactor - 1) / upFactor)
+        , m_phases(m_up * m_tapsPerPhase, Sample(0))
+        , m_history(m_tapsPerPhase)
+    {
+        assert(upFactor > 0 && downFactor > 0 && !prototype.empty());
+
+        // phase p holds h[p + L * k], reversed to line up with the oldest-first history
+        for (size_t phase = 0; phase < m_up; ++phase)
+            for (size_t k = 0; k < m_tapsPerPhase; ++k)
+                if (size_t index = phase + m_up * k; index < prototype.size())
+                    m_phases[phase * m_tapsPerPhase + (m_tapsPerPhase - 1 - k)] = prototype[index];
+    }
+
+    size_t upFactor() const     { return m_up; }
+    size_t downFactor() const   { return m_down; }
+    size_t tapsPerPhase() const { return m_tapsPerPhase; }
+
+    // calls emit(Sample) for each output sample
+    template <typename Emit>
+    void process(std::span<const Sample> input, Emit&& emit)
+    {
+        for (Sample sample : input)
+        {
+            m_history.push(sample);
+
+            // every output which falls between this input and the next one
+            for (; m_phase < m_up; m_phase += m_down)
+                emit(detail::dotProduct(&m_phases[m_phase * m_tapsPerPhase], m_history.recent().data(), m_tapsPerPhase));
+
+            m_phase -= m_up;
+        }
+    }
+
+    // consumes up to 'maxInput' samples from the front of 'input' and pushes the outputs to the back of 'output'
+    // (which drops its oldest samples if it overflows, as usual). Returns the number of consumed samples
+    template <typename InputBuffer, typename OutputBuffer>
+    size_t process(CircularBuffer<Sample, InputBuffer>& input, CircularBuffer<Sample, OutputBuffer>& output, size_t maxInput = SIZE_MAX)
+    {
+        auto emit = [&](Sample sample) { output.pushBack(sample); };
+
+        SpanPair<Sample> block = input.peek(maxInput);
+        process(std::span<const Sample>(block.m_first), emit);
+        process(std::span<const Sample>(block.m_second), emit);
+
+        input.release(block.size());
+        return block.size();
+    }
+
+private:
+
+    size_t              m_up;
+    size_t              m_down;
+    size_t              m_tapsPerPhase;
+    std::vector<Sample> m_phases;       // L rows of tapsPerPhase reversed coefficients
+    DelayLine<Sample>   m_history;
+    size_t              m_phase = 0;    // position of the next output on the upsampled grid, relative to the newest input
+};
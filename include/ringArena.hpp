@@ -0,0 +1,147 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>   // less
+#include <memory_resource>
+
+/**
+ * Wrapping bump allocator: a std::pmr::memory_resource for per-request and per-frame scratch memory
+ * which is released roughly in allocation order.
+ *
+ * Allocation bumps the tail of a byte ring and wraps to the buffer begin like pushBack does; memory is
+ * reclaimed in FIFO order: releasing the oldest live block moves the head over it and over every younger
+ * block which has already been released. A block released out of order just waits for the older ones.
+ *
+ * Blocks are tracked in a CircularBuffer of {begin, end, released} records addressed by their sequence
+ * number, which is stored right before each payload, so deallocation is O(1) plus the FIFO reclaim.
+ * When the ring or the record buffer is full the request goes to the upstream resource instead.
+ */
+class RingArenaResource : public std::pmr::memory_resource
+{
+    struct Block
+    {
+        size_t m_begin    = 0;
+        size_t m_end      = 0;
+        bool   m_released = false;
+    };
+
+    using Sequence = uint64_t;
+
+public:
+
+    explicit RingArenaResource(size_t bytes, size_t maxBlocks = 0, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_upstream(upstream)
+        , m_capacity(bytes)
+        , m_buffer(static_cast<std::byte*>(upstream->allocate(bytes, alignof(std::max_align_t))))
+        , m_blocks(maxBlocks != 0 ? maxBlocks : bytes / 64 + 1)
+    {
+    }
+
+    RingArenaResource(const RingArenaResource&)            = delete;
+    RingArenaResource& operator=(const RingArenaResource&) = delete;
+
+    ~RingArenaResource() override
+    {
+        m_upstream->deallocate(m_buffer, m_capacity, alignof(std::max_align_t));
+    }
+
+    size_t capacity() const                { return m_capacity; }
+    size_t liveBlocks() const              { return m_blocks.size(); }     // including released ones waiting for older blocks
+    size_t liveUpstreamAllocations() const { return m_liveUpstreamAllocations; }   // not deallocated yet
+
+    // bytes between head and tail, including alignment padding and blocks waiting to be reclaimed
+    size_t bytesInUse() const
+    {
+        if (m_blocks.empty())
+            return 0;
+
+        const size_t head = m_blocks.front().m_begin;
+        return m_tail > head ? m_tail - head : m_capacity - head + m_tail;
+    }
+
+protected:
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (m_blocks.empty())
+            m_tail = 0;     // everything has been reclaimed: restart from the beginning, less wrapping
+
+        if (m_blocks.size() < m_blocks.capacity())
+        {
+            // a zero-byte block still takes a byte, or it could be placed at the very end of the buffer where
+            // do_deallocate() wouldn't recognize it as ours
+            const size_t placed = std::max<size_t>(bytes, 1);
+
+            const size_t head    = m_blocks.empty() ? m_tail : m_blocks.front().m_begin;
+            const bool   wrapped = !m_blocks.empty() && m_tail <= head;
+
+            // try at the tail first, then wrap around to the buffer begin, as long as the head is not reached
+            if (void* payload = tryPlace(m_tail, wrapped ? head : m_capacity, wrapped, placed, alignment))
+                return payload;
+
+            if (!wrapped)
+                if (void* payload = tryPlace(0, head, !m_blocks.empty(), placed, alignment))
+                    return payload;
+        }
+
+        ++m_liveUpstreamAllocations;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+    {
+        // std::less: upstream blocks are different allocations, which the built-in '<' doesn't order
+        std::byte* payload = static_cast<std::byte*>(pointer);
+        if (std::less<>()(payload, m_buffer) || !std::less<>()(payload, m_buffer + m_capacity))
+        {
+            --m_liveUpstreamAllocations;
+            m_upstream->deallocate(pointer, bytes, alignment);
+            return;
+        }
+
+        Sequence sequence;
+        std::memcpy(&sequence, payload - sizeof(Sequence), sizeof(Sequence));
+        m_blocks.at(sequence).m_released = true;
+
+        // FIFO reclaim: the head moves over every released block at the front
+        while (!m_blocks.empty() && m_blocks.front().m_released)
+            m_blocks.popFront();
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+
+    std::pmr::memory_resource* m_upstream;
+    const size_t               m_capacity;
+    std::byte*                 m_buffer;
+    CircularBuffer<Block>      m_blocks;
+    size_t                     m_tail = 0;
+    size_t                     m_liveUpstreamAllocations = 0;
+
+    // places a block into [begin, limit): the sequence number goes right before the aligned payload.
+    // 'mustStayBelow' keeps the end strictly below the limit, so a wrapped tail never catches up with the head
+    void* tryPlace(size_t begin, size_t limit, bool mustStayBelow, size_t bytes, size_t alignment)
+    {
+        alignment = std::max(alignment, alignof(Sequence));
+
+        const uintptr_t base    = reinterpret_cast<uintptr_t>(m_buffer);
+        const uintptr_t payload = (base + begin + sizeof(Sequence) + alignment - 1) / alignment * alignment;
+        const size_t    end     = static_cast<size_t>(payload - base) + bytes;
+
+        if (end > limit || (mustStayBelow && end == limit))
+            return nullptr;
+
+        const Sequence sequence = m_blocks.endSequence();
+        m_blocks.pushBack(Block{ begin, end, false });
+        m_tail = end;
+
+        std::byte* result = m_buffer + (payload - base);
+        std::memcpy(result - sizeof(Sequence), &sequence, sizeof(Sequence));
+        return result;
+    }
+};
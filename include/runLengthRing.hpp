@@ -0,0 +1,190 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+
+#include <algorithm>  // min
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+
+// 'm_length' consecutive samples equal to 'm_value'
+template <typename T>
+struct Run
+{
+    T        m_value{};
+    uint64_t m_length = 0;
+};
+
+/**
+ * Ring of samples stored as runs of equal values, for status and gauge streams which repeat the same value
+ * for long stretches.
+ *
+ * Runs are kept in a CircularBuffer: pushing a value equal to back() extends the back run, any other value
+ * starts a new one. Capacity, size() and mostRecent() are in logical samples: when the samples exceed the
+ * logical capacity the front run is shrunk, or dropped once it's empty. When the ring of runs itself is
+ * full, the whole front run is dropped to make room.
+ *
+ * Iteration expands the runs lazily, sample by sample, without materializing them.
+ */
+template <typename T, typename Buffer = VectorBuffer<Run<T>>>
+class RunLengthRing
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    using Runs = CircularBuffer<Run<T>, Buffer>;
+
+    struct PrivateDummy;
+
+public:
+
+    class const_iterator;
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    RunLengthRing(SizeType maxRuns, uint64_t capacity)
+        : m_runs    (maxRuns)
+        , m_capacity(capacity)
+    {
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    explicit RunLengthRing(uint64_t capacity)
+        : m_runs    ()
+        , m_capacity(capacity)
+    {
+    }
+
+    uint64_t size() const     { return m_size; }         // samples
+    uint64_t capacity() const { return m_capacity; }     // samples
+    bool     empty() const    { return m_size == 0; }
+    size_t   runCount() const { return m_runs.size(); }
+
+    const T& front() const    { return m_runs.front().m_value; }
+    const T& back() const     { return m_runs.back().m_value; }
+
+    const Runs& runs() const  { return m_runs; }
+
+    const_iterator begin() const { return const_iterator(m_runs.begin(), 0); }
+    const_iterator end() const   { return const_iterator(m_runs.end(), 0); }
+
+    void pushBack(const T& value)
+    {
+        if (m_capacity == 0)
+            return;
+
+        if (!m_runs.empty() && m_runs.back().m_value == value)
+        {
+            ++m_runs.back().m_length;
+        }
+        else
+        {
+            if (m_runs.size() == m_runs.capacity())
+                dropFront(m_runs.front().m_length);
+            m_runs.pushBack(Run<T>{ value, 1 });
+        }
+
+        if (++m_size > m_capacity)
+            dropFront(m_size - m_capacity);
+    }
+
+    void popFront()
+    {
+        assert(!empty());
+        dropFront(1);
+    }
+
+    // the last 'count' samples, expanded lazily
+    auto mostRecent(uint64_t count) const &
+    {
+        count = std::min(count, m_size);
+
+        // walk back over the runs which are taken completely, then start inside the first one which isn't
+        auto run = m_runs.end();
+        while (count > 0)
+        {
+            --run;
+            if (run->m_length >= count)
+                return std::ranges::subrange(const_iterator(run, run->m_length - count), end());
+            count -= run->m_length;
+        }
+        return std::ranges::subrange(const_iterator(run, 0), end());
+    }
+
+    void mostRecent(uint64_t count) && = delete;                // can't return a subrange of a temporary
+
+private:
+
+    Runs     m_runs;
+    uint64_t m_capacity;
+    uint64_t m_size = 0;
+
+    // removes 'count' samples from the front, run by run
+    void dropFront(uint64_t count)
+    {
+        assert(count <= m_size);
+        m_size -= count;
+        while (count > 0)
+        {
+            Run<T>& front = m_runs.front();
+            if (front.m_length > count)
+            {
+                front.m_length -= count;
+                return;
+            }
+            count -= front.m_length;
+            m_runs.popFront();
+        }
+    }
+};
+
+// forward iterator which repeats each run's value m_length times
+template <typename T, typename Buffer>
+class RunLengthRing<T, Buffer>::const_iterator
+{
+    using RunIterator = typename Runs::const_iterator;
+
+    RunIterator m_run    = {};
+    uint64_t    m_offset = 0;     // within the run
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = T;
+    using pointer           = const T*;
+    using reference         = const T&;
+
+    const_iterator() = default;
+
+    const_iterator(RunIterator run, uint64_t offset)
+        : m_run(run)
+        , m_offset(offset)
+    {}
+
+    const_iterator& operator++()
+    {
+        if (++m_offset == m_run->m_length)
+        {
+            ++m_run;
+            m_offset = 0;
+        }
+        return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+        const_iterator ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    friend bool operator==(const const_iterator& left, const const_iterator& right)
+    {
+        return left.m_run == right.m_run && left.m_offset == right.m_offset;
+    }
+
+    reference operator*() const  { return m_run->m_value; }
+    pointer   operator->() const { return &m_run->m_value; }
+};
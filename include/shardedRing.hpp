@@ -0,0 +1,163 @@
+#pragma once
+
+#include "circularBufferConfig.hpp"
+#include "circularBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+/**
+ * Sharded history ring for many writer threads.
+ *
+ * Every writer thread is pinned to one shard, a CircularBuffer behind its own mutex on its own cache line.
+ * Threads are assigned round-robin modulo the shard count: while there are no more threads than shards each
+ * writes alone and never touches shared memory, beyond that threads share shards and contend on their mutex.
+ * Elements are stamped with a Clock timestamp, taken under the shard lock so that each shard is in timestamp
+ * order; mostRecent(n) merges the newest elements of all shards with a heap, and aggregate() combines
+ * per-shard partial results, e.g. sums or histograms.
+ * Each shard drops its own oldest elements on overflow, so the merged history covers the last
+ * 'capacityPerShard' writes of every shard rather than a global count.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename T, typename Clock = std::chrono::steady_clock>
+class ShardedRing
+{
+    struct Entry
+    {
+        uint64_t m_timestamp = 0;
+        T        m_value     = {};
+    };
+
+    struct alignas(detail::k_cacheLineSize) Shard
+    {
+        mutable std::mutex    m_mutex;
+        CircularBuffer<Entry> m_ring;
+
+        explicit Shard(size_t capacity) : m_ring(capacity) {}
+    };
+
+public:
+
+    explicit ShardedRing(size_t capacityPerShard, size_t shardCount = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        assert(shardCount > 0 && "a ShardedRing needs at least one shard");
+        m_shards.reserve(shardCount);
+        for (size_t i = 0; i < shardCount; ++i)
+            m_shards.push_back(std::make_unique<Shard>(capacityPerShard));
+    }
+
+    size_t shardCount() const { return m_shards.size(); }
+
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const std::unique_ptr<Shard>& shard : m_shards)
+        {
+            std::lock_guard lock(shard->m_mutex);
+            total += shard->m_ring.size();
+        }
+        return total;
+    }
+
+    template <typename Convertible>
+    void pushBack(Convertible&& value)
+    {
+        Shard& shard = threadShard();
+        std::lock_guard lock(shard.m_mutex);
+        // stamped under the lock: a thread sharing the shard can't insert an older stamp after a newer one
+        shard.m_ring.pushBack(Entry{ static_cast<uint64_t>(Clock::now().time_since_epoch().count()), T(std::forward<Convertible>(value)) });
+    }
+
+    // with the caller's timestamp, which must not go back within a shard: mostRecent() merges shards assuming
+    // each one is in timestamp order, e.g. every writer thread stamps in order and has a shard of its own
+    template <typename Convertible>
+    void pushBackAt(uint64_t timestamp, Convertible&& value)
+    {
+        Shard& shard = threadShard();
+        std::lock_guard lock(shard.m_mutex);
+        assert((shard.m_ring.empty() || shard.m_ring.back().m_timestamp <= timestamp) && "timestamps must not decrease within a shard");
+        shard.m_ring.pushBack(Entry{ timestamp, T(std::forward<Convertible>(value)) });
+    }
+
+    // up to 'count' newest elements of all shards, oldest first like CircularBuffer::mostRecent(); each shard
+    // contributes from its last 'count' writes
+    std::vector<T> mostRecent(size_t count) const
+    {
+        // a copy of each shard's tail keeps the locks short
+        std::vector<std::vector<Entry>> tails(m_shards.size());
+        for (size_t i = 0; i < m_shards.size(); ++i)
+        {
+            std::lock_guard lock(m_shards[i]->m_mutex);
+            auto recent = m_shards[i]->m_ring.mostRecent(count);
+            tails[i].assign(recent.begin(), recent.end());
+        }
+
+        // heap of per-shard cursors, newest first
+        using Cursor = std::pair<size_t /*shard*/, size_t /*remaining*/>;
+        auto older = [&](const Cursor& left, const Cursor& right)
+        {
+            uint64_t leftStamp  = tails[left.first][left.second - 1].m_timestamp;
+            uint64_t rightStamp = tails[right.first][right.second - 1].m_timestamp;
+            return leftStamp != rightStamp ? leftStamp < rightStamp : left.first < right.first;
+        };
+
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(older)> heap(older);
+        for (size_t i = 0; i < tails.size(); ++i)
+            if (!tails[i].empty())
+                heap.emplace(i, tails[i].size());
+
+        std::vector<T> result;
+        result.reserve(count);
+        while (result.size() < count && !heap.empty())
+        {
+            Cursor cursor = heap.top();
+            heap.pop();
+
+            result.push_back(std::move(tails[cursor.first][cursor.second - 1].m_value));
+            if (--cursor.second > 0)
+                heap.push(cursor);
+        }
+
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    // perShard(range of const T&) -> Partial is called under each shard's lock, combine(Partial, Partial) -> Partial
+    template <typename PerShard, typename Combine>
+    auto aggregate(PerShard&& perShard, Combine&& combine) const
+    {
+        auto partialOf = [&](const Shard& shard)
+        {
+            std::lock_guard lock(shard.m_mutex);
+            return perShard(shard.m_ring | std::views::transform([](const Entry& entry) -> const T& { return entry.m_value; }));
+        };
+
+        auto result = partialOf(*m_shards.front());
+        for (size_t i = 1; i < m_shards.size(); ++i)
+            result = combine(std::move(result), partialOf(*m_shards[i]));
+
+        return result;
+    }
+
+private:
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+
+    // threads are spread round-robin in the order of their first write, modulo the shard count
+    Shard& threadShard() const
+    {
+        static std::atomic<size_t> s_nextThread = 0;
+        thread_local size_t t_thread = s_nextThread.fetch_add(1, std::memory_order_relaxed);
+        return *m_shards[t_thread % m_shards.size()];
+    }
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
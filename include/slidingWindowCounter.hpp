@@ -0,0 +1,175 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Sliding-window event counter for rate limiting: "how many events in the last N seconds".
+ *
+ * Instead of a timestamp per event, the window is split into 'Buckets' time slices and only a count per
+ * slice is kept: a CircularBuffer of counts whose back() is the current slice. The ring is advanced lazily
+ * on access by pushing empty slices, which overwrites the slices that fell out of the window, and a running
+ * total is kept up to date, so record() and countInWindow() are O(1) amortized.
+ * Precision is one slice: events in the oldest slice are counted until the whole slice has left the window.
+ * A slice's count saturates at UINT32_MAX, so that the running total always matches the slices it evicts.
+ */
+template <size_t Buckets = 60, typename Clock = std::chrono::steady_clock>
+class SlidingWindowCounter
+{
+public:
+
+    using Duration  = typename Clock::duration;
+    using TimePoint = typename Clock::time_point;
+
+    // the window is Buckets * bucketDuration long
+    explicit SlidingWindowCounter(Duration bucketDuration)
+        : m_bucketDuration(bucketDuration)
+    {
+    }
+
+    Duration window() const { return m_bucketDuration * static_cast<int64_t>(Buckets); }
+
+    void record(uint32_t events = 1, TimePoint now = Clock::now())
+    {
+        advanceTo(now);
+        add(events);
+    }
+
+    uint64_t countInWindow(TimePoint now = Clock::now())
+    {
+        advanceTo(now);
+        return m_total;
+    }
+
+    // rate limiter: records the event only if the window has fewer than 'limit' events
+    bool tryRecord(uint64_t limit, TimePoint now = Clock::now())
+    {
+        if (countInWindow(now) >= limit)
+            return false;
+
+        add(1);
+        return true;
+    }
+
+private:
+
+    Duration m_bucketDuration;
+    int64_t  m_bucket = INT64_MIN;      // absolute index of the slice at back()
+    uint64_t m_total  = 0;
+    CircularBuffer<uint32_t, ConstexprSizeBuffer<uint32_t, Buckets>> m_counts;
+
+    // into the current slice, as much as its count can still hold
+    void add(uint32_t events)
+    {
+        const uint32_t added = std::min(events, std::numeric_limits<uint32_t>::max() - m_counts.back());
+        m_counts.back() += added;
+        m_total += added;
+    }
+
+    void advanceTo(TimePoint now)
+    {
+        const int64_t bucket = now.time_since_epoch() / m_bucketDuration;
+        if (bucket <= m_bucket)
+            return;     // same slice, or the clock went backwards: count into the current slice
+
+        // the whole window has expired: no need to walk through every empty slice
+        const int64_t steps = m_bucket == INT64_MIN || bucket - m_bucket > static_cast<int64_t>(Buckets)
+            ? static_cast<int64_t>(Buckets)
+            : bucket - m_bucket;
+
+        for (int64_t i = 0; i < steps; ++i)
+        {
+            if (m_counts.size() == m_counts.capacity())
+                m_total -= m_counts.front();    // about to be overwritten
+            m_counts.pushBack(0u);
+        }
+
+        m_bucket = bucket;
+    }
+};
+
+/**
+ * Lock-free variant for limiters shared between threads. Each slot is an atomic word holding the slice
+ * index (low 32 bits of it) and the count, so a stale slot is recognized and reset by the first record()
+ * in a new slice with a single CAS. countInWindow() sums the slots which belong to the window: O(Buckets).
+ * A slot's count saturates at UINT32_MAX instead of carrying into the slice index.
+ */
+template <size_t Buckets = 60, typename Clock = std::chrono::steady_clock>
+class ConcurrentSlidingWindowCounter
+{
+public:
+
+    using Duration  = typename Clock::duration;
+    using TimePoint = typename Clock::time_point;
+
+    explicit ConcurrentSlidingWindowCounter(Duration bucketDuration)
+        : m_bucketDuration(bucketDuration)
+    {
+    }
+
+    Duration window() const { return m_bucketDuration * static_cast<int64_t>(Buckets); }
+
+    void record(uint32_t events = 1, TimePoint now = Clock::now())
+    {
+        const uint32_t slice = sliceOf(now);
+        std::atomic<uint64_t>& slot = m_slots[slice % Buckets];
+
+        uint64_t current = slot.load(std::memory_order_relaxed);
+        uint64_t updated;
+        do
+        {
+            if (sliceIn(current) == slice)
+            {
+                const uint32_t count = countIn(current);
+                updated = pack(slice, count + std::min(events, std::numeric_limits<uint32_t>::max() - count));
+            }
+            else if (countIn(current) == 0 || isNewer(slice, sliceIn(current)))
+            {
+                updated = pack(slice, events);     // left over from an older lap: start over
+            }
+            else
+            {
+                // a stale timestamp: the slot already holds a later lap, so this slice has left the window
+                return;
+            }
+        }
+        while (!slot.compare_exchange_weak(current, updated, std::memory_order_relaxed));
+    }
+
+    uint64_t countInWindow(TimePoint now = Clock::now()) const
+    {
+        const uint32_t slice = sliceOf(now);
+
+        uint64_t total = 0;
+        for (const std::atomic<uint64_t>& slot : m_slots)
+        {
+            const uint64_t value = slot.load(std::memory_order_relaxed);
+            if (static_cast<uint32_t>(slice - sliceIn(value)) < Buckets)    // modular: survives the 32-bit wrap
+                total += countIn(value);
+        }
+
+        return total;
+    }
+
+private:
+
+    static_assert(Buckets < (uint64_t(1) << 31));
+
+    Duration                                   m_bucketDuration;
+    std::array<std::atomic<uint64_t>, Buckets> m_slots = {};     // slice << 32 | count
+
+    uint32_t sliceOf(TimePoint now) const { return static_cast<uint32_t>(now.time_since_epoch() / m_bucketDuration); }
+
+    static uint64_t pack(uint32_t slice, uint32_t count) { return (uint64_t(slice) << 32) | count; }
+    static uint32_t sliceIn(uint64_t value)              { return static_cast<uint32_t>(value >> 32); }
+    static uint32_t countIn(uint64_t value)              { return static_cast<uint32_t>(value); }
+
+    // modular like countInWindow(): survives the 32-bit wrap
+    static bool isNewer(uint32_t slice, uint32_t than)   { return static_cast<int32_t>(slice - than) > 0; }
+};
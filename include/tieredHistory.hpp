@@ -0,0 +1,419 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+#include "boundedQueue.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+// segments are mapped with POSIX mmap; a Windows MappedFile (CreateFileMapping/MapViewOfFile) has to be built
+// and run by the Windows CI before TieredHistory can be offered there
+#if defined(_WIN32)
+#error "TieredHistory isn't supported on Windows yet"
+#endif
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// a file of fixed size mapped read-write into memory: created (or truncated) by the constructor, unmapped by the destructor
+class MappedFile
+{
+public:
+
+    MappedFile(const std::filesystem::path& path, size_t bytes)
+        : m_bytes(bytes)
+    {
+        const int file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file < 0)
+            throwErrno("open", path);
+
+        if (::ftruncate(file, static_cast<off_t>(bytes)) != 0)
+        {
+            const int error = errno;
+            ::close(file);
+            throw std::system_error(error, std::generic_category(), "ftruncate " + path.string());
+        }
+
+        void* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        const int error = errno;
+        ::close(file);      // the mapping keeps the file open
+        if (data == MAP_FAILED)
+            throw std::system_error(error, std::generic_category(), "mmap " + path.string());
+
+        m_data = static_cast<std::byte*>(data);
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        ::munmap(m_data, m_bytes);
+    }
+
+    std::byte* data() const { return m_data; }
+    size_t     size() const { return m_bytes; }
+
+private:
+
+    std::byte* m_data  = nullptr;
+    size_t     m_bytes = 0;
+
+    [[noreturn]] static void throwErrno(const char* what, const std::filesystem::path& path)
+    {
+        throw std::system_error(errno, std::generic_category(), what + (" " + path.string()));
+    }
+};
+
+/**
+ * Long history of trivially copyable elements with only the recent part in memory.
+ *
+ * The recent elements are in a CircularBuffer. Instead of being overwritten, the element pushBack() is
+ * about to evict is copied into a pre-allocated batch, and full batches are handed through a BoundedQueue
+ * to a writer thread which appends them to memory-mapped segment files of 'segmentCapacity' elements,
+ * named after the sequence number of their first element. The pushing thread never allocates nor touches
+ * the disk; if the writer falls behind by more than k_batches batches, pushBack() waits for it.
+ *
+ * Every element keeps the sequence number it got in the ring, and at() and forEach() read any retained
+ * sequence transparently: from the ring, from the batch being filled, or from the mapped segments (waiting
+ * for the writer if the batch is still in flight). With 'maxSegments' the oldest segment files are deleted.
+ * lowerBound() binary searches the whole history, e.g. by a timestamp inside the elements.
+ *
+ * Pushes and reads are made by one thread, as with CircularBuffer. Segment files are a spill area of this
+ * instance, not a recovery log: they're rewritten when a new history is created in the same directory.
+ * POSIX only for now.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename T>
+class TieredHistory
+{
+    static_assert(std::is_trivially_copyable_v<T>, "elements are stored as raw bytes on disk");
+
+public:
+
+    static constexpr size_t k_batches = 8;      // in flight to the writer at most
+
+    TieredHistory(size_t ringCapacity, std::filesystem::path directory, size_t segmentCapacity = 1 << 20, size_t batchSize = 4096, size_t maxSegments = 0)
+        : m_ring           (ringCapacity)
+        , m_directory      (std::move(directory))
+        , m_segmentCapacity(segmentCapacity)
+        , m_batchSize      (std::min(batchSize, segmentCapacity))
+        , m_maxSegments    (maxSegments)
+        , m_batchStorage   (std::make_unique<T[]>(k_batches * m_batchSize))
+        , m_free           (k_batches)
+        , m_full           (k_batches)
+    {
+        assert(ringCapacity > 0 && segmentCapacity > 0 && batchSize > 0);
+        std::filesystem::create_directories(m_directory);
+
+        for (size_t i = 0; i < k_batches; ++i)
+        {
+            m_batches[i].m_elements = &m_batchStorage[i * m_batchSize];
+            m_free.tryPush(&m_batches[i]);
+        }
+
+        m_writer = std::thread([this] { writerLoop(); });
+    }
+
+    TieredHistory(const TieredHistory&)            = delete;
+    TieredHistory& operator=(const TieredHistory&) = delete;
+
+    ~TieredHistory()
+    {
+        handOverStaging();
+        waitForWriter(m_spilledEnd);
+        m_stop.store(true, std::memory_order_release);
+        m_writer.join();
+    }
+
+    uint64_t oldestSequence() const { return m_oldestSequence.load(std::memory_order_acquire); }
+    uint64_t endSequence() const    { return m_ring.endSequence(); }
+    uint64_t size() const           { return endSequence() - oldestSequence(); }
+
+    // the in-memory part
+    const CircularBuffer<T>& recent() const { return m_ring; }
+
+    void pushBack(const T& value)
+    {
+        if (m_ring.size() == m_ring.capacity())
+            spill(m_ring.front(), m_ring.frontSequence());
+        m_ring.pushBack(value);
+    }
+
+    // throws std::out_of_range if the element was deleted with its segment or hasn't been pushed yet,
+    // or the writer's error if the element couldn't be written
+    T at(uint64_t sequence)
+    {
+        if (sequence >= m_ring.frontSequence())
+            return m_ring.at(sequence);
+
+        if (m_staging && m_staging->m_count > 0 && sequence >= m_staging->m_firstSequence)
+            return m_staging->m_elements[sequence - m_staging->m_firstSequence];
+
+        T    result{};
+        bool found = false;
+        auto copy  = [&](const T& element) { result = element; found = true; };
+        forEachOnDisk(sequence, sequence + 1, copy);
+        if (!found)
+            throw std::out_of_range("TieredHistory: sequence " + std::to_string(sequence) + " has been deleted");
+        return result;
+    }
+
+    // visits the retained elements in [from, to), oldest first, wherever they are. Elements whose segment the
+    // writer deletes during the call are skipped
+    template <typename Function>
+    void forEach(uint64_t from, uint64_t to, Function&& function)
+    {
+        from = std::max(from, oldestSequence());
+        to   = std::min(to, endSequence());
+        if (from >= to)
+            return;
+
+        const uint64_t stagingBegin = m_staging ? m_staging->m_firstSequence : m_spilledEnd;
+        if (from < stagingBegin)
+            forEachOnDisk(from, std::min(to, stagingBegin), function);
+
+        for (uint64_t sequence = std::max(from, stagingBegin); sequence < std::min(to, m_ring.frontSequence()); ++sequence)
+            function(std::as_const(m_staging->m_elements[sequence - stagingBegin]));
+
+        for (const T& element : m_ring.since(std::max(from, m_ring.frontSequence())))
+        {
+            if (m_ring.sequenceOf(element) >= to)
+                break;
+            function(element);
+        }
+    }
+
+    // the first sequence whose 'keyOf(element)' isn't less than 'key', or endSequence(); keys must not decrease
+    template <typename Key, typename KeyOf>
+    uint64_t lowerBound(const Key& key, KeyOf&& keyOf)
+    {
+        uint64_t first = oldestSequence();
+        uint64_t last  = endSequence();
+        while (first < last)
+        {
+            const uint64_t middle = first + (last - first) / 2;
+
+            bool retained = false;
+            bool less     = false;
+            forEach(middle, middle + 1, [&](const T& element) { retained = true; less = keyOf(element) < key; });
+
+            if (!retained)
+                first = std::max(middle + 1, oldestSequence());   // its segment was deleted meanwhile: search what's left
+            else if (less)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        return first;
+    }
+
+    // blocks until every evicted element is in a segment file
+    void flush()
+    {
+        handOverStaging();
+        waitForWriter(m_spilledEnd);
+        rethrowWriterError();
+    }
+
+private:
+
+    struct Batch
+    {
+        T*       m_elements      = nullptr;
+        uint64_t m_firstSequence = 0;
+        size_t   m_count         = 0;
+    };
+
+    struct Segment
+    {
+        uint64_t                    m_firstSequence = 0;
+        std::filesystem::path       m_path;
+        std::unique_ptr<MappedFile> m_file;
+
+        const T* elements() const { return reinterpret_cast<const T*>(m_file->data()); }
+        T*       elements()       { return reinterpret_cast<T*>(m_file->data()); }
+    };
+
+    CircularBuffer<T>     m_ring;
+    std::filesystem::path m_directory;
+    const size_t          m_segmentCapacity;
+    const size_t          m_batchSize;
+    const size_t          m_maxSegments;
+
+    // pushing thread
+    std::unique_ptr<T[]>  m_batchStorage;
+    Batch                 m_batches[k_batches];
+    Batch*                m_staging    = nullptr;   // being filled
+    uint64_t              m_spilledEnd = 0;         // sequence after the last evicted element
+
+    BoundedQueue<Batch*>  m_free;
+    BoundedQueue<Batch*>  m_full;
+
+    // shared with the writer
+    std::atomic<uint64_t> m_persistedEnd   = 0;     // sequence after the last element written to a segment
+    std::atomic<uint64_t> m_oldestSequence = 0;
+    std::atomic<bool>     m_failed         = false;
+    std::exception_ptr    m_writerError;            // published by m_failed
+    std::mutex            m_segmentsMutex;          // the writer adds and deletes segments, readers look them up
+    std::deque<Segment>   m_segments;
+    std::atomic<bool>     m_stop = false;
+    std::thread           m_writer;                 // started by the constructor when everything else is initialized
+
+    void spill(const T& element, uint64_t sequence)
+    {
+        if (!m_staging)
+        {
+            while (!m_free.tryPop(m_staging))
+                std::this_thread::yield();      // the writer is k_batches behind: backpressure
+
+            m_staging->m_firstSequence = sequence;
+            m_staging->m_count         = 0;
+        }
+
+        m_staging->m_elements[m_staging->m_count++] = element;
+        m_spilledEnd = sequence + 1;
+
+        if (m_staging->m_count == m_batchSize)
+            handOverStaging();
+    }
+
+    void handOverStaging()
+    {
+        if (!m_staging)
+            return;
+
+        const bool pushed = m_full.tryPush(m_staging);   // there are only k_batches batches: never full
+        assert(pushed);
+        (void)pushed;
+        m_staging = nullptr;
+    }
+
+    void waitForWriter(uint64_t sequence)
+    {
+        while (m_persistedEnd.load(std::memory_order_acquire) < sequence && !m_failed.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    void rethrowWriterError()
+    {
+        if (m_failed.load(std::memory_order_acquire))
+            std::rethrow_exception(m_writerError);
+    }
+
+    template <typename Function>
+    void forEachOnDisk(uint64_t from, uint64_t to, Function& function)
+    {
+        waitForWriter(to);      // in flight: the writer is on it
+        rethrowWriterError();
+
+        // the caller's view of oldestSequence() may be stale by now, the writer can't change it while we hold the lock
+        std::lock_guard lock(m_segmentsMutex);
+        from = std::max(from, oldestSequence());
+        if (from >= to || m_segments.empty())
+            return;
+
+        // segments are sorted by their first sequence and all but the last one are full
+        size_t index = static_cast<size_t>((from - m_segments.front().m_firstSequence) / m_segmentCapacity);
+        for (uint64_t sequence = from; sequence < to; ++index)
+        {
+            const Segment& segment = m_segments[index];
+            const uint64_t segmentEnd = std::min(to, segment.m_firstSequence + m_segmentCapacity);
+            for (; sequence < segmentEnd; ++sequence)
+                function(std::as_const(segment.elements()[sequence - segment.m_firstSequence]));
+        }
+    }
+
+    void writerLoop()
+    {
+        using namespace std::chrono_literals;
+
+        uint64_t written = 0;   // in the last segment
+        for (;;)
+        {
+            Batch* batch = nullptr;
+            if (!m_full.tryPop(batch))
+            {
+                if (m_stop.load(std::memory_order_acquire))
+                    return;
+                std::this_thread::sleep_for(100us);
+                continue;
+            }
+
+            if (!m_failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    write(*batch, written);
+                }
+                catch (...)
+                {
+                    m_writerError = std::current_exception();
+                    m_failed.store(true, std::memory_order_release);
+                }
+            }
+
+            m_persistedEnd.store(batch->m_firstSequence + batch->m_count, std::memory_order_release);
+            m_free.tryPush(batch);
+        }
+    }
+
+    void write(const Batch& batch, uint64_t& written)
+    {
+        for (size_t copied = 0; copied < batch.m_count; )
+        {
+            if (m_segments.empty() || written == m_segmentCapacity)
+            {
+                openSegment(batch.m_firstSequence + copied);
+                written = 0;
+            }
+
+            // only the writer changes m_segments, so it may read it without the lock
+            const size_t count = std::min<size_t>(batch.m_count - copied, m_segmentCapacity - written);
+            std::memcpy(m_segments.back().elements() + written, batch.m_elements + copied, count * sizeof(T));
+            written += count;
+            copied  += count;
+        }
+    }
+
+    void openSegment(uint64_t firstSequence)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%020llu.segment", static_cast<unsigned long long>(firstSequence));
+
+        Segment segment;
+        segment.m_firstSequence = firstSequence;
+        segment.m_path          = m_directory / name;
+        segment.m_file          = std::make_unique<MappedFile>(segment.m_path, m_segmentCapacity * sizeof(T));
+
+        std::lock_guard lock(m_segmentsMutex);
+        m_segments.push_back(std::move(segment));
+
+        if (m_maxSegments != 0 && m_segments.size() > m_maxSegments)
+        {
+            std::filesystem::path deleted = std::move(m_segments.front().m_path);
+            m_segments.pop_front();
+            m_oldestSequence.store(m_segments.front().m_firstSequence, std::memory_order_release);
+
+            std::error_code ignored;    // a file which can't be removed is just left behind
+            std::filesystem::remove(deleted, ignored);
+        }
+    }
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
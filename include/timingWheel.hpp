@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Intrusive timer: embed it or derive from it, the wheel links it into its slot lists without allocating.
+ * It must not be destroyed while scheduled.
+ */
+class TimerNode
+{
+    TimerNode*  m_next     = nullptr;
+    TimerNode** m_pprev    = nullptr;   // the 'm_next' (or slot head) pointing to this node, null if not scheduled
+    uint64_t    m_deadline = 0;
+
+    template <size_t, size_t> friend class TimingWheel;
+
+public:
+
+    TimerNode() = default;
+    TimerNode(const TimerNode&) = delete;
+    TimerNode& operator=(const TimerNode&) = delete;
+
+    ~TimerNode() { assert(!scheduled() && "cancel the timer before destroying it"); }
+
+    bool     scheduled() const { return m_pprev != nullptr; }
+    uint64_t deadline() const  { return m_deadline; }
+};
+
+/**
+ * Hierarchical timing wheel: O(1) schedule and cancel, expiry in batches per tick.
+ *
+ * Level 'l' is a circular array of 2^SlotBits intrusive timer lists, each slot covering 2^(SlotBits * l) ticks,
+ * and the slot index is the corresponding digit of the deadline, just like a ring buffer position wraps
+ * around. A timer goes to the lowest level which can tell its deadline apart from 'now'; when the lower
+ * levels wrap around, the next slot of the level above is cascaded down, so each timer moves at most
+ * Levels - 1 times. Deadlines beyond the range of the top level are parked at its far end and re-placed
+ * when they get cascaded.
+ */
+template <size_t Levels = 4, size_t SlotBits = 6>
+class TimingWheel
+{
+    static_assert(Levels > 0 && SlotBits > 0 && Levels * SlotBits < 64);
+
+    static constexpr size_t   k_slots = size_t(1) << SlotBits;
+    static constexpr uint64_t k_mask  = k_slots - 1;
+    static constexpr uint64_t k_range = uint64_t(1) << (Levels * SlotBits);   // ticks ahead which can be told apart
+
+    using Slot = TimerNode*;    // head of a singly-linked list with back-pointers
+
+public:
+
+    explicit TimingWheel(uint64_t now = 0) : m_now(now) {}
+
+    TimingWheel(const TimingWheel&)            = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    ~TimingWheel()
+    {
+        for (auto& level : m_levels)
+            for (Slot& slot : level)
+                while (slot)
+                    unlink(*slot);
+    }
+
+    uint64_t now() const  { return m_now; }
+    size_t   size() const { return m_size; }
+
+    // absolute deadline in ticks; a deadline which has already passed expires on the next tick.
+    // Reschedules the timer if it's already scheduled
+    void schedule(TimerNode& timer, uint64_t deadline)
+    {
+        if (timer.scheduled())
+            cancel(timer);
+
+        timer.m_deadline = std::max(deadline, m_now + 1);
+        place(timer);
+        ++m_size;
+    }
+
+    void scheduleAfter(TimerNode& timer, uint64_t ticks) { schedule(timer, m_now + std::max<uint64_t>(ticks, 1)); }
+
+    void cancel(TimerNode& timer)
+    {
+        if (!timer.scheduled())
+            return;
+
+        unlink(timer);
+        --m_size;
+    }
+
+    // moves time forward tick by tick and calls onExpired(TimerNode&) for every due timer.
+    // The timer is already unscheduled then, so the callback may schedule it again or destroy it
+    template <typename OnExpired>
+    size_t advance(uint64_t ticks, OnExpired&& onExpired)
+    {
+        size_t expiredCount = 0;
+        for (uint64_t i = 0; i < ticks; ++i)
+        {
+            ++m_now;
+            cascade();
+
+            // detach the due slot first: callbacks may schedule new timers into it
+            Slot expired = m_levels[0][m_now & k_mask];
+            m_levels[0][m_now & k_mask] = nullptr;
+            if (expired)
+                expired->m_pprev = &expired;
+
+            while (expired)
+            {
+                TimerNode& timer = *expired;
+                unlink(timer);
+                --m_size;
+
+                assert(timer.m_deadline == m_now);
+                ++expiredCount;
+                onExpired(timer);
+            }
+        }
+
+        return expiredCount;
+    }
+
+private:
+
+    std::array<std::array<Slot, k_slots>, Levels> m_levels = {};
+    uint64_t m_now  = 0;
+    size_t   m_size = 0;
+
+    static uint64_t digit(uint64_t tick, size_t level) { return (tick >> (level * SlotBits)) & k_mask; }
+
+    void place(TimerNode& timer)
+    {
+        // beyond the wheel: park at the top level's farthest slot for now
+        const uint64_t deadline = std::min(timer.m_deadline, m_now + k_range - 1);
+
+        // the lowest level whose parent block contains both 'now' and the deadline
+        size_t level = 0;
+        while (level + 1 < Levels && (deadline >> ((level + 1) * SlotBits)) != (m_now >> ((level + 1) * SlotBits)))
+            ++level;
+
+        link(timer, m_levels[level][digit(deadline, level)]);
+    }
+
+    // 'now' has just entered a new slot at level 0: re-place the timers of every level whose lower digits wrapped
+    void cascade()
+    {
+        size_t top = 0;
+        while (top + 1 < Levels && digit(m_now, top) == 0)
+            ++top;
+
+        for (size_t level = top; level > 0; --level)
+        {
+            Slot moving = m_levels[level][digit(m_now, level)];
+            m_levels[level][digit(m_now, level)] = nullptr;
+            if (moving)
+                moving->m_pprev = &moving;
+
+            while (moving)
+            {
+                TimerNode& timer = *moving;
+                unlink(timer);
+                place(timer);
+            }
+        }
+    }
+
+    static void link(TimerNode& timer, Slot& head)
+    {
+        timer.m_next  = head;
+        timer.m_pprev = &head;
+        if (head)
+            head->m_pprev = &timer.m_next;
+        head = &timer;
+    }
+
+    static void unlink(TimerNode& timer)
+    {
+        *timer.m_pprev = timer.m_next;
+        if (timer.m_next)
+            timer.m_next->m_pprev = timer.m_pprev;
+
+        timer.m_next  = nullptr;
+        timer.m_pprev = nullptr;
+    }
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "circularBufferConfig.hpp"
+#include "circularBuffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Wait-free "latest value" exchange between one writer and one reader.
+ * The writer never blocks and never waits for the reader, the reader always sees the most recent
+ * complete value. It's the lock-free counterpart of 'mostRecent(1)' on a ring that nobody reads in full.
+ *
+ * Three slots rotate between the writer (back), the reader (front) and the middle one which holds
+ * the last published value. Publishing and fetching are a single atomic exchange of the middle index.
+ * 'Buffer' is one of the CircularBuffer storage backends, only its first three elements are used.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename T, typename Buffer = ConstexprSizeBuffer<T, 3>>
+class TripleBuffer
+{
+    static constexpr uint8_t k_slotCount = 3;
+    static constexpr uint8_t k_indexMask = 0x3;
+    static constexpr uint8_t k_dirtyBit  = 0x4;   // middle slot holds a value the reader hasn't fetched yet
+
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    struct PrivateDummy;
+
+public:
+
+    template <typename Dummy = PrivateDummy>
+    requires(k_needSizeInConstructor)
+    TripleBuffer()
+        : m_buffer(k_slotCount)
+    {
+        assert(std::size(m_buffer) >= k_slotCount);
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    TripleBuffer()
+        : m_buffer()
+    {
+        assert(std::size(m_buffer) >= k_slotCount);
+    }
+
+    TripleBuffer(const TripleBuffer&)            = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /*
+     * Writer side
+     */
+
+    // the slot owned by the writer: fill it in place and then publish()
+    T& backBuffer() { return slot(m_back); }
+
+    void publish()
+    {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_back | k_dirtyBit), std::memory_order_acq_rel);
+        m_back = previous & k_indexMask;
+    }
+
+    template <typename Convertible>
+    void write(Convertible&& value)
+    {
+        backBuffer() = std::forward<Convertible>(value);
+        publish();
+    }
+
+    /*
+     * Reader side
+     */
+
+    bool hasUpdate() const { return (m_middle.load(std::memory_order_relaxed) & k_dirtyBit) != 0; }
+
+    // takes the latest published value if there is one, returns whether the front buffer has changed
+    bool update()
+    {
+        if (!hasUpdate())
+            return false;
+
+        uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & k_indexMask;
+        return true;
+    }
+
+    // the slot owned by the reader: the value that was the latest one at the last update()
+    const T& frontBuffer() const { return slot(m_front); }
+
+    const T& read()
+    {
+        update();
+        return frontBuffer();
+    }
+
+private:
+
+    Buffer m_buffer;
+
+    alignas(detail::k_cacheLineSize) std::atomic<uint8_t> m_middle = 1;   // shared, all the traffic goes through here
+    alignas(detail::k_cacheLineSize) uint8_t              m_back   = 0;   // writer-owned
+    alignas(detail::k_cacheLineSize) uint8_t              m_front  = 2;   // reader-owned
+
+    T&       slot(uint8_t index)       { return *(std::begin(m_buffer) + index); }
+    const T& slot(uint8_t index) const { return *(std::begin(m_buffer) + index); }
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "circularBuffer.hpp"
+#include "byteBudgetBuffer.hpp"     // PayloadSize
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// one command of an UndoHistory
+template <typename Command>
+struct HistoryEntry
+{
+    Command  m_command{};
+    uint64_t m_bytesBefore = 0;     // bytes of every entry pushed before this one, since the history was created
+    bool     m_sealed      = false; // nothing may be merged into it anymore
+};
+
+/**
+ * Undo/redo history with a cursor over a ring of commands: old commands fall off the front automatically.
+ *
+ * Commands before the cursor can be undone, the ones after it redone. push() drops the redo tail with
+ * CircularBuffer::truncateFrom(), then appends, unless the command can be merged into the last one (e.g. typing
+ * one character after another): a 'tryMerge(back, incoming)' which returns true coalesces them into the back
+ * slot instead.
+ *
+ * The total size of the commands, by 'sizeOf', is capped: the oldest commands are evicted to stay under the
+ * cap, and so are commands over the element capacity of the ring. Each entry keeps a running byte total,
+ * so truncating the redo tail adjusts the byte count in O(1). The payloads of truncated and evicted commands
+ * are released right away, so the cap bounds what is actually held: every command is released at most once,
+ * which costs amortized O(1) per push.
+ */
+template <typename Command, typename SizeOf = PayloadSize, typename Buffer = VectorBuffer<HistoryEntry<Command>>>
+class UndoHistory
+{
+    static constexpr bool k_needSizeInConstructor = Buffer::k_needSizeInConstructor;
+
+    struct PrivateDummy;
+
+public:
+
+    template <std::integral SizeType>
+    requires(k_needSizeInConstructor)
+    UndoHistory(SizeType maxCommands, size_t byteCap, SizeOf sizeOf = SizeOf())
+        : m_entries(maxCommands)
+        , m_byteCap(byteCap)
+        , m_sizeOf (std::move(sizeOf))
+    {
+    }
+
+    template <typename Dummy = PrivateDummy>
+    requires(!k_needSizeInConstructor)
+    explicit UndoHistory(size_t byteCap, SizeOf sizeOf = SizeOf())
+        : m_entries()
+        , m_byteCap(byteCap)
+        , m_sizeOf (std::move(sizeOf))
+    {
+    }
+
+    size_t size() const      { return m_entries.size(); }
+    size_t capacity() const  { return m_entries.capacity(); }
+    size_t bytes() const     { return empty() ? 0 : static_cast<size_t>(m_bytesEnd - m_entries.front().m_bytesBefore); }
+    size_t byteCap() const   { return m_byteCap; }
+    bool   empty() const     { return m_entries.empty(); }
+
+    size_t undoCount() const { return static_cast<size_t>(m_cursor - m_entries.frontSequence()); }
+    size_t redoCount() const { return static_cast<size_t>(m_entries.endSequence() - m_cursor); }
+    bool   canUndo() const   { return undoCount() > 0; }
+    bool   canRedo() const   { return redoCount() > 0; }
+
+    template <typename Convertible>
+    void push(Convertible&& command)
+    {
+        push(std::forward<Convertible>(command), [](Command&, const Command&) { return false; });
+    }
+
+    // 'tryMerge(Command& back, const Command& incoming) -> bool' folds 'incoming' into the last command if they're
+    // compatible. Only a command which wasn't undone or sealed is merged into
+    template <typename Convertible, typename TryMerge>
+    void push(Convertible&& command, TryMerge&& tryMerge)
+    {
+        Command incoming(std::forward<Convertible>(command));
+        truncateRedo();
+
+        if (!empty() && !m_entries.back().m_sealed && tryMerge(m_entries.back().m_command, std::as_const(incoming)))
+        {
+            HistoryEntry<Command>& back = m_entries.back();
+            m_bytesEnd = back.m_bytesBefore + m_sizeOf(std::as_const(back.m_command));
+        }
+        else
+        {
+            if (m_entries.size() == m_entries.capacity())
+                evictFront();
+
+            HistoryEntry<Command>& entry = m_entries.pushBack(HistoryEntry<Command>{ std::move(incoming), m_bytesEnd, false });
+            m_bytesEnd += m_sizeOf(std::as_const(entry.m_command));
+        }
+
+        m_cursor = m_entries.endSequence();
+        while (bytes() > m_byteCap && size() > 1)   // the newest command is kept even if it's larger than the cap
+            evictFront();
+    }
+
+    // the next push() starts a new command, e.g. after a pause in typing or a save
+    void seal()
+    {
+        if (!empty())
+            m_entries.back().m_sealed = true;
+    }
+
+    // the command to revert, or nullptr if there's nothing to undo
+    const Command* undo()
+    {
+        if (!canUndo())
+            return nullptr;
+
+        HistoryEntry<Command>& entry = m_entries.at(--m_cursor);
+        entry.m_sealed = true;
+        return &entry.m_command;
+    }
+
+    // the command to apply again, or nullptr if there's nothing to redo
+    const Command* redo()
+    {
+        if (!canRedo())
+            return nullptr;
+
+        return &m_entries.at(m_cursor++).m_command;
+    }
+
+    void clear()
+    {
+        m_cursor = m_entries.frontSequence();
+        truncateRedo();
+    }
+
+private:
+
+    CircularBuffer<HistoryEntry<Command>, Buffer> m_entries;
+    size_t                                        m_byteCap;
+    SizeOf                                        m_sizeOf;
+    uint64_t                                      m_bytesEnd = 0;  // running byte total after the back entry
+    uint64_t                                      m_cursor   = 0;  // sequence of the first command to redo
+
+    void truncateRedo()
+    {
+        if (!canRedo())
+            return;
+
+        const uint64_t end = m_entries.endSequence();
+        m_bytesEnd = m_entries.at(m_cursor).m_bytesBefore;
+
+        // the ring just moves its tail, but the commands' payloads are freed now to honour the byte cap
+        if constexpr (!std::is_trivially_destructible_v<Command>)
+            for (uint64_t sequence = m_cursor; sequence < end; ++sequence)
+                release(m_entries.at(sequence).m_command);
+
+        m_entries.truncateFrom(m_cursor);
+    }
+
+    void evictFront()
+    {
+        release(m_entries.front().m_command);
+        m_entries.popFront();
+        m_cursor = std::max(m_cursor, m_entries.frontSequence());
+    }
+
+    static void release(Command& command)
+    {
+        [[maybe_unused]] Command released = std::move(command);
+    }
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "circularBufferConfig.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Chase-Lev work-stealing deque (Lê, Pop, Cohen, Zappa Nardelli, "Correct and Efficient Work-Stealing
+ * for Weak Memory Models", PPoPP'13).
+ *
+ * The owner thread pushes and pops at the bottom using only relaxed accesses and fences: it touches the
+ * contended 'top' with a CAS just when the deque is down to its last element. Any other thread may steal
+ * from the top with a CAS. Elements live in a circular array indexed by ever-growing 64-bit positions,
+ * so the same ring arithmetic as in CircularBuffer applies; the array doubles when the owner fills it up.
+ *
+ * T is meant to be small and trivially copyable, typically a task pointer.
+ */
+CIRCULAR_BUFFER_BEGIN_CACHE_ALIGNED
+template <typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "elements are read by thieves concurrently with the owner");
+
+    class CircularArray
+    {
+        const int64_t                      m_capacity;    // power of two
+        std::unique_ptr<std::atomic<T>[]>  m_items;
+
+    public:
+        explicit CircularArray(int64_t capacity)
+            : m_capacity(capacity)
+            , m_items(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity)))
+        {
+            assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+        }
+
+        int64_t capacity() const { return m_capacity; }
+
+        T    get(int64_t position) const        { return m_items[position & (m_capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t position, T value)     { m_items[position & (m_capacity - 1)].store(value, std::memory_order_relaxed); }
+
+        std::unique_ptr<CircularArray> grow(int64_t top, int64_t bottom) const
+        {
+            auto bigger = std::make_unique<CircularArray>(m_capacity * 2);
+            for (int64_t i = top; i < bottom; ++i)
+                bigger->put(i, get(i));
+            return bigger;
+        }
+    };
+
+public:
+
+    explicit WorkStealingDeque(size_t initialCapacity = 64)
+    {
+        int64_t capacity = 1;
+        while (capacity < static_cast<int64_t>(initialCapacity))
+            capacity *= 2;
+
+        m_arrays.push_back(std::make_unique<CircularArray>(capacity));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // approximate when called concurrently
+    size_t size() const
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top    = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // owner only
+    void push(T value)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top    = m_top.load(std::memory_order_acquire);
+        CircularArray* array = m_array.load(std::memory_order_relaxed);
+
+        if (bottom - top > array->capacity() - 1)
+        {
+            // thieves may still read the old array: it's retired, not deleted, until the deque dies
+            m_arrays.push_back(array->grow(top, bottom));
+            array = m_arrays.back().get();
+            m_array.store(array, std::memory_order_release);
+        }
+
+        array->put(bottom, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // owner only: LIFO end
+    std::optional<T> pop()
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        CircularArray* array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);   // was empty
+            return std::nullopt;
+        }
+
+        std::optional<T> result = array->get(bottom);
+        if (top == bottom)
+        {
+            // the last element: race against thieves for it
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                result = std::nullopt;
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    // any thread: FIFO end. Returns nullopt if the deque is empty or another thread won the race
+    std::optional<T> steal()
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return std::nullopt;
+
+        CircularArray* array = m_array.load(std::memory_order_acquire);
+        T value = array->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return std::nullopt;
+
+        return value;
+    }
+
+private:
+
+    alignas(detail::k_cacheLineSize) std::atomic<int64_t>        m_top    = 0;   // thieves' end
+    alignas(detail::k_cacheLineSize) std::atomic<int64_t>        m_bottom = 0;   // owner's end
+    alignas(detail::k_cacheLineSize) std::atomic<CircularArray*> m_array  = nullptr;
+
+    std::vector<std::unique_ptr<CircularArray>> m_arrays;    // owner only: the current array and the retired ones
+};
+CIRCULAR_BUFFER_END_CACHE_ALIGNED
@@ -0,0 +1,139 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asyncLogger.hpp"
+
+TEST_CASE("BoundedQueue: FIFO, full and empty")
+{
+    BoundedQueue<int> queue(3);     // rounded up to 4
+    CHECK(queue.capacity() == 4);
+
+    int value = 0;
+    CHECK(!queue.tryPop(value));
+
+    for (int i = 0; i < 4; ++i)
+        CHECK(queue.tryPush(i));
+    CHECK(!queue.tryPush(4));
+    CHECK(queue.size() == 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.tryPop(value));
+        CHECK(value == i);
+    }
+    CHECK(!queue.tryPop(value));
+}
+
+TEST_CASE("BoundedQueue: concurrent producers and consumers")
+{
+    constexpr int k_perProducer = 20000;
+    constexpr int k_producers   = 3;
+    constexpr int k_consumers   = 2;
+
+    BoundedQueue<int> queue(64);
+    std::atomic<long long> sum   = 0;
+    std::atomic<int>       count = 0;
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < k_producers; ++p)
+        threads.emplace_back([&] { for (int i = 1; i <= k_perProducer; ++i) while (!queue.tryPush(i)) std::this_thread::yield(); });
+
+    for (int c = 0; c < k_consumers; ++c)
+    {
+        threads.emplace_back([&]
+        {
+            int value = 0;
+            while (count.load() < k_producers * k_perProducer)
+            {
+                if (queue.tryPop(value))
+                {
+                    sum += value;
+                    ++count;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    CHECK(count.load() == k_producers * k_perProducer);
+    CHECK(sum.load() == (long long)k_producers * k_perProducer * (k_perProducer + 1) / 2);
+}
+
+namespace
+{
+    enum class Side { Buy = 1, Sell = 2 };
+
+    struct CollectingSink
+    {
+        std::mutex   m_mutex;
+        std::string  m_text;
+        int          m_batches = 0;
+
+        AsyncLogger::Sink sink()
+        {
+            return [this](std::string_view batch)
+            {
+                std::lock_guard lock(m_mutex);
+                m_text += batch;
+                ++m_batches;
+            };
+        }
+    };
+}
+
+TEST_CASE("AsyncLogger: formats records on the background thread")
+{
+    CollectingSink collected;
+    {
+        AsyncLogger logger(16, collected.sink());
+        CHECK(logger.log("plain"));
+        CHECK(logger.log("order {} {} at {} ok={} {}", 42, Side::Sell, 1.5, true, 'x'));
+        CHECK(logger.log("{} and {} but no third {}", -7LL, 3u));
+        logger.flush();
+
+        std::lock_guard lock(collected.m_mutex);
+        CHECK(collected.m_text == "plain\norder 42 2 at 1.5 ok=true x\n-7 and 3 but no third {}\n");
+    }
+}
+
+TEST_CASE("AsyncLogger: blocking policy loses nothing, drop policy counts")
+{
+    constexpr int k_threads = 4;
+    constexpr int k_perThread = 2000;
+
+    CollectingSink collected;
+    {
+        AsyncLogger logger(8, collected.sink(), AsyncLogger::OverflowPolicy::Block);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < k_threads; ++t)
+            threads.emplace_back([&, t] { for (int i = 0; i < k_perThread; ++i) logger.log("{} {}", t, i); });
+        for (std::thread& t : threads)
+            t.join();
+    }   // destructor flushes
+
+    CHECK(std::count(collected.m_text.begin(), collected.m_text.end(), '\n') == k_threads * k_perThread);
+
+    CollectingSink lossy;
+    uint64_t dropped = 0;
+    int accepted = 0;
+    {
+        AsyncLogger logger(2, lossy.sink(), AsyncLogger::OverflowPolicy::Drop);
+        for (int i = 0; i < 10000; ++i)
+            accepted += logger.log("{}", i) ? 1 : 0;
+        dropped = logger.dropped();
+    }
+
+    CHECK(accepted + (int)dropped == 10000);
+    CHECK(std::count(lossy.m_text.begin(), lossy.m_text.end(), '\n') == accepted);
+}
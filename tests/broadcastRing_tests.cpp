@@ -0,0 +1,112 @@
+#include "doctest.h"
+
+#include <thread>
+#include <vector>
+
+#include "broadcastRing.hpp"
+
+TEST_CASE("BroadcastRing: every reader sees every element when keeping up")
+{
+    BroadcastRing<int> ring(4);
+    CHECK(ring.capacity() == 4);
+
+    auto first  = ring.makeReader();
+    auto second = ring.makeReader();
+
+    int value = -1;
+    CHECK(!first.tryRead(value));
+
+    for (int i = 0; i < 3; ++i)
+        ring.pushBack(i);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(first.tryRead(value));
+        CHECK(value == i);
+    }
+    CHECK(!first.tryRead(value));
+
+    REQUIRE(second.tryRead(value));
+    CHECK(value == 0);
+    CHECK(second.lost() == 0);
+    CHECK(second.position() == 1);
+}
+
+TEST_CASE("BroadcastRing: lapped reader skips to the oldest valid element")
+{
+    BroadcastRing<int> ring(3);          // rounded up to 4
+    CHECK(ring.capacity() == 4);
+
+    auto reader = ring.makeReader();
+    for (int i = 0; i < 10; ++i)
+        ring.pushBack(i);
+
+    std::vector<int> received;
+    int value = 0;
+    while (reader.tryRead(value))
+        received.push_back(value);
+
+    CHECK(received == std::vector<int>{6, 7, 8, 9});
+    CHECK(reader.lost() == 6);
+
+    auto late = ring.makeReaderFromOldest();
+    CHECK(late.position() == 6);
+    CHECK(late.tryRead(value));
+    CHECK(value == 6);
+}
+
+TEST_CASE("BroadcastRing: concurrent writer and readers")
+{
+    struct Message
+    {
+        uint64_t m_sequence = 0;
+        uint64_t m_payload[5] = {};   // all equal to ~m_sequence unless torn
+    };
+
+    constexpr uint64_t k_messages = 100000;
+    BroadcastRing<Message> ring(64);
+
+    std::vector<BroadcastRing<Message>::Reader> readers = { ring.makeReader(), ring.makeReader(), ring.makeReader() };
+    std::vector<uint64_t> received(readers.size());
+    std::vector<int> consistent(readers.size(), 1);
+    std::vector<std::thread> threads;
+
+    for (size_t r = 0; r < readers.size(); ++r)
+    {
+        threads.emplace_back([&, r]
+        {
+            Message message;
+            uint64_t expectedAtLeast = 0;
+            while (received[r] + readers[r].lost() < k_messages)
+            {
+                if (!readers[r].tryRead(message))
+                    continue;
+
+                ++received[r];
+                for (uint64_t word : message.m_payload)
+                    consistent[r] = consistent[r] && word == ~message.m_sequence;
+                consistent[r] = consistent[r] && message.m_sequence >= expectedAtLeast;
+                expectedAtLeast = message.m_sequence + 1;
+            }
+        });
+    }
+
+    for (uint64_t i = 0; i < k_messages; ++i)
+    {
+        Message message;
+        message.m_sequence = i;
+        for (uint64_t& word : message.m_payload)
+            word = ~i;
+        ring.pushBack(message);
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    for (size_t r = 0; r < readers.size(); ++r)
+    {
+        CHECK(consistent[r]);
+        CHECK(received[r] + readers[r].lost() == k_messages);
+        CHECK(readers[r].position() == k_messages);
+    }
+}
@@ -0,0 +1,60 @@
+#include "doctest.h"
+
+#include <string>
+#include <vector>
+
+#include "byteBudgetBuffer.hpp"
+
+TEST_CASE("ByteBudgetBuffer: evicts by payload size")
+{
+    auto length = [](const std::string& s) { return s.size(); };
+    ByteBudgetBuffer<std::string, decltype(length)> buffer(100, 10, length);
+
+    CHECK(buffer.pushBack("aaaa"));
+    CHECK(buffer.pushBack("bbb"));
+    CHECK(buffer.pushBack("cc"));
+    CHECK(buffer.bytes() == 9);
+    CHECK(buffer.size() == 3);
+
+    CHECK(buffer.pushBack("dddd"));         // 13 bytes: "aaaa" goes
+    CHECK(buffer.bytes() == 9);
+    CHECK(buffer.front() == "bbb");
+
+    CHECK(buffer.pushBack("eeeeeeeeee"));   // the whole budget
+    CHECK(buffer.size() == 1);
+    CHECK(buffer.bytes() == 10);
+
+    CHECK_FALSE(buffer.pushBack("fffffffffff"));   // can never fit, nothing is evicted
+    CHECK(buffer.back() == "eeeeeeeeee");
+
+    buffer.pushBack("");
+    buffer.setByteBudget(5);
+    CHECK(buffer.size() == 1);
+    CHECK(buffer.bytes() == 0);
+}
+
+TEST_CASE("ByteBudgetBuffer: element count is a secondary limit")
+{
+    ByteBudgetBuffer<std::vector<int>, PayloadSize, ConstexprSizeBuffer<std::vector<int>, 4>> buffer(1 << 20);
+    CHECK(buffer.capacity() == 4);
+
+    for (int i = 0; i < 10; ++i)
+        buffer.pushBack(std::vector<int>(static_cast<size_t>(i), i));
+
+    CHECK(buffer.size() == 4);
+    CHECK(buffer.front().size() == 6);
+    CHECK(buffer.bytes() == 4 * sizeof(std::vector<int>) + (6 + 7 + 8 + 9) * sizeof(int));
+
+    // mixed traffic stays under the budget
+    buffer.setByteBudget(4 * sizeof(std::vector<int>) + 20 * sizeof(int));
+    for (int i = 0; i < 100; ++i)
+    {
+        buffer.pushBack(std::vector<int>(static_cast<size_t>(i % 17), i));
+        CHECK(buffer.bytes() <= buffer.byteBudget());
+    }
+
+    size_t bytes = 0;
+    for (const std::vector<int>& element : buffer)
+        bytes += PayloadSize()(element);
+    CHECK(bytes == buffer.bytes());
+}
@@ -0,0 +1,115 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "channel.hpp"
+
+namespace
+{
+    ChannelTask produce(Channel<int>& channel, int first, int count)
+    {
+        for (int i = first; i < first + count; ++i)
+            co_await channel.push(i);
+    }
+
+    ChannelTask consume(Channel<int>& channel, int count, std::vector<int>& received)
+    {
+        for (int i = 0; i < count; ++i)
+            received.push_back(co_await channel.pop());
+    }
+}
+
+TEST_CASE("Channel: producer and consumer through a small ring")
+{
+    SingleThreadedExecutor executor;
+    Channel<int> channel(executor, 4);
+    std::vector<int> received;
+
+    consume(channel, 100, received).spawn(executor);   // starts first and parks on the empty channel
+    produce(channel, 0, 100).spawn(executor);
+    executor.run();
+
+    std::vector<int> expected;
+    for (int i = 0; i < 100; ++i)
+        expected.push_back(i);
+    CHECK(received == expected);
+    CHECK(channel.size() == 0);
+}
+
+TEST_CASE("Channel: parked producers are admitted in FIFO order")
+{
+    SingleThreadedExecutor executor;
+    Channel<int> channel(executor, 2);
+    std::vector<int> received;
+
+    produce(channel, 0, 5).spawn(executor);
+    produce(channel, 100, 5).spawn(executor);
+    executor.run();
+
+    CHECK(channel.size() == 2);     // both producers are parked on the full channel now
+
+    consume(channel, 10, received).spawn(executor);
+    executor.run();
+
+    CHECK(received.size() == 10);
+    CHECK(std::count_if(received.begin(), received.end(), [](int v) { return v < 100; }) == 5);
+
+    // each producer's values keep their order
+    std::vector<int> low, high;
+    for (int v : received)
+        (v < 100 ? low : high).push_back(v);
+    CHECK(low == std::vector<int>{0, 1, 2, 3, 4});
+    CHECK(high == std::vector<int>{100, 101, 102, 103, 104});
+}
+
+TEST_CASE("Channel: capacity 0 hands every value over directly")
+{
+    SingleThreadedExecutor executor;
+    Channel<int> channel(executor, 0);
+    std::vector<int> received;
+
+    // either side may park first
+    produce(channel, 0, 50).spawn(executor);
+    consume(channel, 100, received).spawn(executor);
+    produce(channel, 50, 50).spawn(executor);
+    executor.run();
+
+    // each producer's values keep their order, and none is lost
+    std::vector<int> first, second;
+    for (int value : received)
+        (value < 50 ? first : second).push_back(value);
+    CHECK(first.size() == 50);
+    CHECK(second.size() == 50);
+    CHECK(std::is_sorted(first.begin(), first.end()));
+    CHECK(std::is_sorted(second.begin(), second.end()));
+    CHECK(channel.capacity() == 0);
+    CHECK(channel.size() == 0);
+}
+
+TEST_CASE("Channel: move-only payload with the std::array based buffer")
+{
+    SingleThreadedExecutor executor;
+    Channel<std::unique_ptr<std::string>, ConstexprSizeBuffer<std::unique_ptr<std::string>, 1>> channel(executor);
+    std::string joined;
+
+    auto producer = [](auto& ch) -> ChannelTask
+    {
+        for (const char* word : { "a", "b", "c" })
+            co_await ch.push(std::make_unique<std::string>(word));
+    };
+
+    auto consumer = [](auto& ch, std::string& out) -> ChannelTask
+    {
+        for (int i = 0; i < 3; ++i)
+            out += *(co_await ch.pop());
+    };
+
+    producer(channel).spawn(executor);
+    consumer(channel, joined).spawn(executor);
+    executor.run();
+
+    CHECK(joined == "abc");
+}
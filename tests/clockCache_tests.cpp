@@ -0,0 +1,129 @@
+#include "doctest.h"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "clockCache.hpp"
+
+TEST_CASE("OpenAddressingIndex: erase keeps the probe runs intact")
+{
+    // the index points into this array, keys are looked up through it
+    std::vector<uint64_t> keys;
+    for (uint64_t i = 0; i < 1000; ++i)
+        keys.push_back(i * 7919);
+
+    auto keyOf = [&](uint32_t slot) -> const uint64_t& { return keys[slot]; };
+
+    OpenAddressingIndex<uint64_t> index(keys.size());
+    for (uint32_t slot = 0; slot < keys.size(); ++slot)
+        index.insert(keys[slot], slot);
+    CHECK(index.size() == keys.size());
+
+    for (uint32_t slot = 0; slot < keys.size(); slot += 3)
+        CHECK(index.erase(keys[slot], slot));
+    CHECK_FALSE(index.erase(keys[0], 0));
+
+    for (uint32_t slot = 0; slot < keys.size(); ++slot)
+    {
+        const uint32_t* found = index.find(keys[slot], keyOf);
+        if (slot % 3 == 0)
+            CHECK(found == nullptr);
+        else
+            CHECK((found && *found == slot));
+    }
+    CHECK(index.find(12345, keyOf) == nullptr);
+}
+
+TEST_CASE("ClockCache: referenced entries get a second chance")
+{
+    ClockCache<int, std::string> cache(3);
+    CHECK(cache.capacity() == 3);
+
+    cache.insertOrAssign(1, "one");
+    cache.insertOrAssign(2, "two");
+    cache.insertOrAssign(3, "three");
+    CHECK(cache.size() == 3);
+
+    REQUIRE(cache.find(1));
+    CHECK(*cache.find(1) == "one");
+
+    // 1 was referenced: the hand clears its bit and evicts 2 instead
+    cache.insertOrAssign(4, "four");
+    CHECK(cache.size() == 3);
+    CHECK(cache.contains(1));
+    CHECK_FALSE(cache.contains(2));
+    CHECK(cache.contains(3));
+
+    // nothing referenced since: the hand goes on with 3, then 1
+    cache.insertOrAssign(5, "five");
+    CHECK_FALSE(cache.contains(3));
+    cache.insertOrAssign(6, "six");
+    CHECK_FALSE(cache.contains(1));
+
+    // assignment doesn't evict
+    cache.insertOrAssign(5, "FIVE");
+    CHECK(*cache.find(5) == "FIVE");
+    CHECK(cache.size() == 3);
+
+    // an erased slot is reused before anything is evicted
+    CHECK(cache.erase(4));
+    CHECK_FALSE(cache.erase(4));
+    cache.insertOrAssign(7, "seven");
+    CHECK(cache.contains(5));
+    CHECK(cache.contains(6));
+    CHECK(cache.contains(7));
+}
+
+TEST_CASE("ClockCache: fixed-size storage and churn")
+{
+    ClockCache<uint32_t, uint32_t, ConstexprSizeBuffer<ClockCacheEntry<uint32_t, uint32_t>, 64>> cache;
+    CHECK(cache.capacity() == 64);
+
+    // a hot set which is always found survives a stream of one-off keys
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        for (uint32_t hot = 0; hot < 8; ++hot)
+            if (!cache.find(hot))
+                cache.insertOrAssign(hot, hot);
+
+        cache.insertOrAssign(1000 + i, i);
+        CHECK(cache.size() <= cache.capacity());
+    }
+
+    for (uint32_t hot = 0; hot < 8; ++hot)
+        CHECK(cache.contains(hot));
+    CHECK(*cache.find(1000 + 9999) == 9999);
+}
+
+TEST_CASE("ConcurrentClockCache: readers and a writer")
+{
+    ConcurrentClockCache<uint32_t, uint64_t> cache(256);
+    for (uint32_t key = 0; key < 128; ++key)
+        cache.insertOrAssign(key, key * 10);
+
+    std::vector<std::thread> readers;
+    std::atomic<bool> wrong = false;
+    for (int reader = 0; reader < 3; ++reader)
+        readers.emplace_back([&]
+        {
+            for (uint32_t i = 0; i < 20000; ++i)
+            {
+                const uint32_t key = i % 512;
+                if (std::optional<uint64_t> value = cache.find(key); value && *value != key * 10)
+                    wrong = true;
+            }
+        });
+
+    for (uint32_t key = 128; key < 2048; ++key)
+        cache.insertOrAssign(key % 512, uint64_t(key % 512) * 10);
+
+    for (std::thread& reader : readers)
+        reader.join();
+
+    CHECK_FALSE(wrong);
+    CHECK(cache.size() == cache.capacity());
+}
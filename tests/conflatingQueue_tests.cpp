@@ -0,0 +1,86 @@
+#include "doctest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "conflatingQueue.hpp"
+
+namespace
+{
+    struct Quote
+    {
+        std::string m_symbol;
+        double      m_price  = 0;
+        uint64_t    m_volume = 0;
+    };
+
+    struct SymbolOf
+    {
+        const std::string& operator()(const Quote& quote) const { return quote.m_symbol; }
+    };
+}
+
+TEST_CASE("ConflatingQueue: the consumer sees only the latest update per key")
+{
+    ConflatingQueue<Quote, SymbolOf> quotes(16);
+
+    quotes.push(Quote{ "AAPL", 100.0, 10 });
+    quotes.push(Quote{ "MSFT", 200.0, 5 });
+    quotes.push(Quote{ "AAPL", 101.0, 20 });
+    quotes.push(Quote{ "AAPL", 102.0, 30 });
+    CHECK(quotes.size() == 2);
+    CHECK(quotes.conflated() == 2);
+
+    CHECK(quotes.front().m_symbol == "AAPL");   // keeps its place in the queue
+    CHECK(quotes.front().m_price == 102.0);
+    CHECK(quotes.front().m_volume == 30);
+    quotes.popFront();
+    CHECK_FALSE(quotes.contains("AAPL"));
+
+    // not pending anymore: queued again behind MSFT
+    quotes.push(Quote{ "AAPL", 103.0, 1 });
+    CHECK(quotes.front().m_symbol == "MSFT");
+    CHECK(quotes.updates().back().m_price == 103.0);
+
+    // a custom merge accumulates the volume
+    auto accumulate = [](Quote& pending, const Quote& update)
+    {
+        pending.m_price   = update.m_price;
+        pending.m_volume += update.m_volume;
+    };
+    quotes.push(Quote{ "MSFT", 201.0, 7 }, accumulate);
+    CHECK(quotes.front().m_price == 201.0);
+    CHECK(quotes.front().m_volume == 12);
+}
+
+TEST_CASE("ConflatingQueue: a burst over few keys stays small")
+{
+    auto keyOf = [](uint32_t update) { return update % 10; };
+    ConflatingQueue<uint32_t, decltype(keyOf), ConstexprSizeBuffer<uint32_t, 32>> queue(keyOf);
+
+    for (uint32_t update = 0; update < 10000; ++update)
+        queue.push(update);
+    CHECK(queue.size() == 10);
+    CHECK(queue.conflated() == 10000 - 10);
+
+    std::vector<uint32_t> latest;
+    while (!queue.empty())
+    {
+        latest.push_back(queue.front());
+        queue.popFront();
+    }
+    CHECK(latest == std::vector<uint32_t>{ 9990, 9991, 9992, 9993, 9994, 9995, 9996, 9997, 9998, 9999 });
+
+    // more keys than capacity: the oldest pending updates are overwritten and forgotten by the index
+    auto wide = [](uint32_t update) { return update; };
+    ConflatingQueue<uint32_t, decltype(wide)> distinct(8, wide);
+    for (uint32_t update = 0; update < 20; ++update)
+        distinct.push(update);
+    CHECK(distinct.size() == 8);
+    CHECK(distinct.front() == 12);
+    CHECK_FALSE(distinct.contains(11));
+    CHECK(distinct.contains(19));
+    distinct.push(19);
+    CHECK(distinct.size() == 8);
+}
@@ -0,0 +1,57 @@
+#include "doctest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dedupWindow.hpp"
+
+TEST_CASE("DedupWindow: duplicates within the window are rejected")
+{
+    DedupWindow<std::string> window(3);
+
+    CHECK(window.pushBack("a"));
+    CHECK(window.pushBack("b"));
+    CHECK_FALSE(window.pushBack("a"));
+    CHECK(window.size() == 2);
+
+    CHECK(window.pushBack("c"));
+    CHECK(window.pushBack("d"));           // evicts "a"
+    CHECK_FALSE(window.contains("a"));
+    CHECK(window.contains("b"));
+    CHECK(window.pushBack("a"));           // seen, but not in the last 3 anymore; evicts "b"
+    CHECK_FALSE(window.contains("b"));
+
+    window.popFront();                      // "c"
+    CHECK_FALSE(window.contains("c"));
+    CHECK(window.contains("d"));
+    CHECK(window.contains("a"));
+    CHECK(std::vector<std::string>(window.keys().begin(), window.keys().end()) == std::vector<std::string>{ "d", "a" });
+
+    window.clear();
+    CHECK(window.empty());
+    CHECK_FALSE(window.contains("d"));
+    CHECK(window.pushBack("d"));
+}
+
+TEST_CASE("DedupWindow: the index stays in sync over many wraps")
+{
+    DedupWindow<uint64_t, ConstexprSizeBuffer<uint64_t, 100>> window;
+    CHECK(window.capacity() == 100);
+
+    // message ids arrive with retransmissions of recent ones
+    uint64_t accepted = 0;
+    for (uint64_t id = 0; id < 100000; ++id)
+    {
+        accepted += window.pushBack(id) ? 1 : 0;
+        if (id >= 10)
+            CHECK_FALSE(window.pushBack(id - 10));
+    }
+    CHECK(accepted == 100000);
+    CHECK(window.size() == 100);
+
+    CHECK(window.contains(99999));
+    CHECK(window.contains(99900));
+    CHECK_FALSE(window.contains(99899));
+    CHECK(window.pushBack(0));
+}
@@ -0,0 +1,67 @@
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "delayLine.hpp"
+
+TEST_CASE("DelayLine: integer taps and the contiguous recent() window")
+{
+    DelayLine<float> line(4);
+    CHECK(line.tap(3) == 0.0f);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        line.push(static_cast<float>(i));
+        CHECK(line.tap(0) == static_cast<float>(i));
+        if (i > 3)
+            CHECK(line.tap(3) == static_cast<float>(i - 3));
+
+        std::span<const float> recent = line.recent();
+        REQUIRE(recent.size() == 4);
+        for (size_t k = 0; k < 4; ++k)
+            CHECK(recent[3 - k] == line.tap(k));
+    }
+}
+
+TEST_CASE("DelayLine: fractional taps")
+{
+    DelayLine<double> line(16);
+    for (int i = 0; i < 16; ++i)
+        line.push(2.0 * i);     // linear ramp: tap(d) == 30 - 2d
+
+    CHECK(line.tapLinear(0.0) == 30.0);
+    CHECK(std::abs(line.tapLinear(2.25) - 25.5) < 1e-12);
+    CHECK(std::abs(line.tapCubic(5.5) - 19.0) < 1e-12);    // cubic is exact on a ramp too
+
+    DelayLine<double> sine(64);
+    for (int i = 0; i < 64; ++i)
+        sine.push(std::sin(0.1 * i));
+    const double delay = 10.3;
+    const double expected = std::sin(0.1 * (63 - delay));
+    CHECK(std::abs(sine.tapCubic(delay) - expected) < 1e-4);
+    CHECK(std::abs(sine.tapLinear(delay) - expected) < 1e-2);
+}
+
+TEST_CASE("FirFilter: matches the direct convolution")
+{
+    std::vector<float> coefficients(37);
+    for (size_t k = 0; k < coefficients.size(); ++k)
+        coefficients[k] = 1.0f / static_cast<float>(k + 1);
+
+    std::vector<float> input(200);
+    for (size_t n = 0; n < input.size(); ++n)
+        input[n] = std::sin(0.05f * static_cast<float>(n)) + (n % 7 == 0 ? 1.0f : 0.0f);
+
+    FirFilter<float> filter(coefficients);
+    std::vector<float> output(input.size());
+    filter.process(input, output);
+
+    for (size_t n = 0; n < input.size(); ++n)
+    {
+        double expected = 0;
+        for (size_t k = 0; k < coefficients.size() && k <= n; ++k)
+            expected += coefficients[k] * input[n - k];
+        CHECK(std::abs(output[n] - expected) < 1e-4);
+    }
+}
@@ -0,0 +1,133 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flightRecorder.hpp"
+
+TEST_CASE("FlightRecorder: per-thread rings merged in timestamp order")
+{
+    struct Tag;
+    using Recorder = FlightRecorder<uint64_t, 256, Tag>;     // room for every event, should the threads share a ring
+
+    constexpr int k_threads = 4;
+    constexpr int k_events  = 50;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < k_threads; ++t)
+    {
+        threads.emplace_back([t]
+        {
+            // interleaved timestamps: thread t records t, t + k_threads, t + 2 * k_threads, ...
+            for (int i = 0; i < k_events; ++i)
+                Recorder::recordAt(static_cast<uint64_t>(i * k_threads + t), static_cast<uint32_t>(t), static_cast<uint64_t>(i));
+        });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    // rings of finished threads are still there
+    std::vector<Recorder::Event> trace = Recorder::dump();
+    REQUIRE(trace.size() == k_threads * k_events);
+
+    for (size_t i = 0; i < trace.size(); ++i)
+    {
+        CHECK(trace[i].m_timestamp == i);
+        CHECK(trace[i].m_id == i % k_threads);
+        CHECK(trace[i].m_payload == i / k_threads);
+    }
+
+    Recorder::clear();
+    CHECK(Recorder::dump().empty());
+}
+
+TEST_CASE("FlightRecorder: a new thread takes over the ring of a finished one")
+{
+    struct Tag;
+    using Recorder = FlightRecorder<int, 8, Tag>;
+
+    // one thread after another: a single ring, so only its last 8 events are kept
+    for (int t = 0; t < 10; ++t)
+        std::thread([t] { Recorder::recordAt(static_cast<uint64_t>(t), 1, t); }).join();
+
+    std::vector<Recorder::Event> trace = Recorder::dump();
+    REQUIRE(trace.size() == 8);
+    for (size_t i = 0; i < trace.size(); ++i)
+    {
+        CHECK(trace[i].m_payload == static_cast<int>(i) + 2);
+        CHECK(trace[i].m_thread == i + 2);      // still told apart
+    }
+}
+
+TEST_CASE("FlightRecorder: ring keeps only the most recent events")
+{
+    struct Tag;
+    using Recorder = FlightRecorder<int, 8, Tag>;
+
+    for (int i = 0; i < 20; ++i)
+        Recorder::record(7, i);
+
+    std::vector<Recorder::Event> trace = Recorder::dump();
+    REQUIRE(trace.size() == 8);
+    CHECK(trace.front().m_payload == 12);
+    CHECK(trace.back().m_payload == 19);
+    CHECK(std::is_sorted(trace.begin(), trace.end(), [](const auto& l, const auto& r) { return l.m_timestamp < r.m_timestamp; }));
+}
+
+TEST_CASE("FlightRecorder: dump() while threads are recording")
+{
+    struct Tag;
+    struct Pair
+    {
+        uint64_t m_first  = 0;
+        uint64_t m_second = 0;     // always equal to m_first: a torn copy would show
+    };
+    using Recorder = FlightRecorder<Pair, 16, Tag>;
+
+    constexpr int k_threads = 3;
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < k_threads; ++t)
+    {
+        threads.emplace_back([t, &stop]
+        {
+            for (uint64_t i = 0; !stop.load(std::memory_order_relaxed); ++i)
+                Recorder::recordAt(i, static_cast<uint32_t>(t), Pair{ i, i });
+        });
+    }
+
+    bool consistent = true;
+    for (int dump = 0; dump < 200; ++dump)
+    {
+        std::vector<Recorder::Event> trace = Recorder::dump();
+        std::vector<uint64_t> last(k_threads, 0);
+        std::vector<bool> seen(k_threads, false);
+
+        for (const Recorder::Event& event : trace)
+        {
+            consistent = consistent && event.m_payload.m_first == event.m_payload.m_second
+                                    && event.m_timestamp == event.m_payload.m_first
+                                    && event.m_id < k_threads;
+            if (event.m_id < k_threads)
+            {
+                // every thread's events in recording order, no duplicates
+                consistent = consistent && (!seen[event.m_id] || event.m_timestamp > last[event.m_id]);
+                seen[event.m_id] = true;
+                last[event.m_id] = event.m_timestamp;
+            }
+        }
+
+        if (dump % 20 == 0)
+            std::this_thread::yield();
+    }
+
+    stop = true;
+    for (std::thread& t : threads)
+        t.join();
+
+    CHECK(consistent);
+    CHECK(Recorder::dump().size() <= k_threads * 16);
+}
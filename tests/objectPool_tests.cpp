@@ -0,0 +1,108 @@
+#include "doctest.h"
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "objectPool.hpp"
+
+TEST_CASE("ObjectPool: acquire, release and reuse keeps capacity")
+{
+    ObjectPool<std::string> pool(3);
+    CHECK(pool.capacity() == 3);
+    CHECK(pool.available() == 3);
+
+    std::string* first = pool.acquire();
+    first->assign(1000, 'x');
+    const size_t grownCapacity = first->capacity();
+    first->clear();
+
+    std::string* second = pool.acquire();
+    std::string* third  = pool.acquire();
+    CHECK(pool.acquire() == nullptr);
+    CHECK(pool.available() == 0);
+    CHECK(std::set<std::string*>{first, second, third}.size() == 3);
+
+    pool.release(second);
+    pool.release(first);
+    pool.release(third);
+
+    // round-robin: the least recently released comes back first
+    CHECK(pool.acquire() == second);
+    std::string* again = pool.acquire();
+    CHECK(again == first);
+    CHECK(again->capacity() == grownCapacity);
+
+    {
+        auto scoped = pool.acquireScoped();
+        CHECK(scoped.get() == third);
+        CHECK(pool.available() == 0);
+    }
+    CHECK(pool.available() == 1);
+}
+
+TEST_CASE("ObjectPool: std::array based free list")
+{
+    ObjectPool<std::vector<int>, ConstexprSizeBuffer<std::vector<int>*, 2>> pool;
+    CHECK(pool.capacity() == 2);
+
+    auto a = pool.acquireScoped();
+    auto b = pool.acquireScoped();
+    CHECK(!pool.acquireScoped());
+    CHECK(pool.owns(a.get()));
+    CHECK(pool.owns(b.get()));
+}
+
+TEST_CASE("ConcurrentObjectPool: release from other threads")
+{
+    constexpr int k_rounds = 10000;
+    ConcurrentObjectPool<std::string> pool(8);
+    BoundedQueue<std::string*> handOff(8);
+
+    std::thread releaser([&]
+    {
+        for (int i = 0; i < k_rounds; ++i)
+        {
+            std::string* message = nullptr;
+            while (!handOff.tryPop(message))
+                std::this_thread::yield();
+            message->clear();
+            pool.release(message);
+        }
+    });
+
+    for (int i = 0; i < k_rounds; ++i)
+    {
+        std::string* message = nullptr;
+        while (!(message = pool.acquire()))
+            std::this_thread::yield();
+
+        *message = "message " + std::to_string(i);
+        while (!handOff.tryPush(message))
+            std::this_thread::yield();
+    }
+
+    releaser.join();
+    CHECK(pool.available() == pool.capacity());
+}
+
+#ifdef NDEBUG
+TEST_CASE("ObjectPool: a double release is ignored in release builds")
+{
+    ObjectPool<std::string> pool(3);
+    std::string* first = pool.acquire();
+    pool.release(first);
+    pool.release(first);
+    CHECK(pool.available() == 3);
+
+    std::set<std::string*> acquired{ pool.acquire(), pool.acquire(), pool.acquire() };
+    CHECK(acquired.size() == 3);
+
+    ConcurrentObjectPool<std::string> concurrent(4);
+    std::string* object = concurrent.acquire();
+    concurrent.release(object);
+    concurrent.release(object);
+    CHECK(concurrent.available() == 4);
+}
+#endif
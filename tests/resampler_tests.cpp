@@ -0,0 +1,79 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "resampler.hpp"
+
+namespace
+{
+    // direct form: upsample by L with zeros, filter, take every M-th sample
+    std::vector<double> referenceResample(const std::vector<double>& input, size_t up, size_t down, const std::vector<double>& h)
+    {
+        std::vector<double> stuffed(input.size() * up, 0.0);
+        for (size_t i = 0; i < input.size(); ++i)
+            stuffed[i * up] = input[i];
+
+        std::vector<double> result;
+        for (size_t n = 0; n < stuffed.size(); n += down)
+        {
+            double y = 0;
+            for (size_t k = 0; k < h.size() && k <= n; ++k)
+                y += h[k] * stuffed[n - k];
+            result.push_back(y);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Resampler: matches the direct upsample-filter-downsample form")
+{
+    const std::pair<size_t, size_t> ratios[] = { {1, 2}, {1, 4}, {2, 3}, {3, 2}, {5, 1} };
+    std::vector<double> input(120);
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = std::sin(0.07 * static_cast<double>(i)) + 0.25 * std::cos(0.31 * static_cast<double>(i));
+
+    for (auto [up, down] : ratios)
+    {
+        std::vector<double> h = Resampler<double>::designLowPass(up, down, 6);
+        Resampler<double> resampler(up, down, h);
+
+        // feed in uneven blocks to check the state carried between calls
+        std::vector<double> output;
+        auto emit = [&](double y) { output.push_back(y); };
+        std::span<const double> rest = input;
+        for (size_t block = 1; !rest.empty(); ++block)
+        {
+            size_t count = std::min(block * 3, rest.size());
+            resampler.process(rest.first(count), emit);
+            rest = rest.subspan(count);
+        }
+
+        std::vector<double> expected = referenceResample(input, up, down, h);
+        REQUIRE(output.size() == expected.size());
+        for (size_t n = 0; n < output.size(); ++n)
+            CHECK(std::abs(output[n] - expected[n]) < 1e-9);
+    }
+}
+
+TEST_CASE("Resampler: decimates from one CircularBuffer into another")
+{
+    CircularBuffer<float> highRate = CircularBuffer<float>(64);
+    CircularBuffer<float> lowRate  = CircularBuffer<float>(16);
+    Resampler<float> decimator(1, 4);
+
+    size_t consumed = 0;
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 40; ++i)
+            highRate.pushBack(1.0f);    // DC
+
+        consumed += decimator.process(highRate, lowRate);
+        CHECK(highRate.empty());
+    }
+
+    CHECK(consumed == 400);
+    CHECK(lowRate.size() == 16);
+    CHECK(std::abs(lowRate.back() - 1.0f) < 0.01f);  // unity DC gain once the filter is filled
+}
@@ -0,0 +1,82 @@
+#include "doctest.h"
+
+#include <string>
+#include <vector>
+
+#include "ringArena.hpp"
+
+TEST_CASE("RingArenaResource: FIFO reclaim and wrap around")
+{
+    RingArenaResource arena(1024);
+
+    void* a = arena.allocate(200, 8);
+    void* b = arena.allocate(200, 8);
+    void* c = arena.allocate(200, 8);
+    CHECK(arena.liveBlocks() == 3);
+    CHECK(arena.liveUpstreamAllocations() == 0);
+
+    // released out of order: nothing is reclaimed until the oldest one goes
+    arena.deallocate(b, 200, 8);
+    CHECK(arena.liveBlocks() == 3);
+    arena.deallocate(a, 200, 8);
+    CHECK(arena.liveBlocks() == 1);
+
+    // doesn't fit at the tail any more: wraps to the beginning, in front of 'c'
+    void* d = arena.allocate(400, 8);
+    CHECK(arena.liveUpstreamAllocations() == 0);
+    CHECK(d < c);
+
+    // no room anywhere: upstream takes it
+    void* e = arena.allocate(600, 8);
+    CHECK(arena.liveUpstreamAllocations() == 1);
+    arena.deallocate(e, 600, 8);
+    CHECK(arena.liveUpstreamAllocations() == 0);
+
+    arena.deallocate(c, 200, 8);
+    arena.deallocate(d, 400, 8);
+    CHECK(arena.liveBlocks() == 0);
+    CHECK(arena.bytesInUse() == 0);
+}
+
+TEST_CASE("RingArenaResource: alignment and pmr containers")
+{
+    RingArenaResource arena(64 * 1024);
+
+    for (size_t alignment : { size_t(1), size_t(8), size_t(16), size_t(64), size_t(256) })
+    {
+        void* p = arena.allocate(24, alignment);
+        CHECK(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+        arena.deallocate(p, 24, alignment);
+    }
+
+    for (int request = 0; request < 100; ++request)
+    {
+        std::pmr::vector<std::pmr::string> words(&arena);
+        for (int i = 0; i < 20; ++i)
+            words.emplace_back(std::string(40, static_cast<char>('a' + i)));
+
+        CHECK(words.size() == 20);
+        CHECK(std::string_view(words.back()) == std::string(40, 't'));
+    }
+
+    CHECK(arena.liveBlocks() == 0);
+    CHECK(arena.liveUpstreamAllocations() == 0);
+}
+
+TEST_CASE("RingArenaResource: a zero-byte block at the end of the buffer")
+{
+    RingArenaResource arena(64);
+
+    // the sequence number takes 8 bytes before each payload: this one ends 8 bytes before the buffer end,
+    // so a zero-byte payload would land exactly on the end
+    void* a = arena.allocate(48, 8);
+    CHECK(arena.bytesInUse() == 56);
+
+    void* empty = arena.allocate(0, 8);
+    CHECK(arena.liveUpstreamAllocations() == 1);    // no room for its byte, upstream takes it
+    arena.deallocate(empty, 0, 8);
+    CHECK(arena.liveUpstreamAllocations() == 0);
+
+    arena.deallocate(a, 48, 8);
+    CHECK(arena.liveBlocks() == 0);
+}
@@ -0,0 +1,71 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "runLengthRing.hpp"
+
+TEST_CASE("RunLengthRing: equal pushes extend the back run")
+{
+    RunLengthRing<std::string> statuses(8, 10);
+    static_assert(std::forward_iterator<RunLengthRing<std::string>::const_iterator>);
+
+    for (int i = 0; i < 4; ++i)
+        statuses.pushBack("up");
+    for (int i = 0; i < 3; ++i)
+        statuses.pushBack("degraded");
+    statuses.pushBack("up");
+
+    CHECK(statuses.size() == 8);
+    CHECK(statuses.runCount() == 3);
+    CHECK(statuses.front() == "up");
+    CHECK(statuses.back() == "up");
+
+    const std::vector<std::string> expanded(statuses.begin(), statuses.end());
+    CHECK(expanded == std::vector<std::string>{ "up", "up", "up", "up", "degraded", "degraded", "degraded", "up" });
+
+    // logical eviction shrinks the head run
+    statuses.pushBack("up");
+    statuses.pushBack("up");
+    statuses.pushBack("up");
+    CHECK(statuses.size() == 10);
+    CHECK(statuses.runs().front().m_length == 3);
+
+    for (int i = 0; i < 4; ++i)
+        statuses.pushBack("down");
+    CHECK(statuses.size() == 10);
+    CHECK(statuses.runCount() == 3);          // the first "up" run is gone
+    CHECK(statuses.front() == "degraded");
+    CHECK(statuses.runs().front().m_length == 2);
+
+    statuses.popFront();
+    statuses.popFront();
+    CHECK(statuses.front() == "up");
+    CHECK(statuses.size() == 8);
+}
+
+TEST_CASE("RunLengthRing: mostRecent() in samples")
+{
+    RunLengthRing<int, ConstexprSizeBuffer<Run<int>, 4>> gauge(1000);
+
+    for (int value : { 1, 2, 3 })
+        for (int i = 0; i < 100; ++i)
+            gauge.pushBack(value);
+
+    CHECK(gauge.size() == 300);
+    CHECK(std::ranges::distance(gauge.mostRecent(150)) == 150);
+    CHECK(std::ranges::count(gauge.mostRecent(150), 2) == 50);
+    CHECK(std::ranges::count(gauge.mostRecent(150), 3) == 100);
+    CHECK(std::ranges::distance(gauge.mostRecent(100)) == 100);
+    CHECK(*gauge.mostRecent(100).begin() == 3);
+    CHECK(std::ranges::distance(gauge.mostRecent(5000)) == 300);
+    CHECK(std::ranges::empty(gauge.mostRecent(0)));
+
+    // no room for a fifth run: the oldest run goes as a whole
+    gauge.pushBack(4);
+    gauge.pushBack(5);
+    CHECK(gauge.runCount() == 4);
+    CHECK(gauge.size() == 202);
+    CHECK(gauge.front() == 2);
+}
@@ -0,0 +1,64 @@
+#include "doctest.h"
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "shardedRing.hpp"
+
+TEST_CASE("ShardedRing: mostRecent merges shards by timestamp")
+{
+    constexpr int k_threads = 4;
+    constexpr int k_perThread = 100;
+    ShardedRing<int> ring(1000, k_threads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < k_threads; ++t)
+    {
+        threads.emplace_back([&ring, t]
+        {
+            // interleaved timestamps across threads, value == timestamp
+            for (int i = 0; i < k_perThread; ++i)
+                ring.pushBackAt(static_cast<uint64_t>(i * k_threads + t), i * k_threads + t);
+        });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    CHECK(ring.size() == k_threads * k_perThread);
+
+    std::vector<int> recent = ring.mostRecent(10);
+    std::vector<int> expected(10);
+    std::iota(expected.begin(), expected.end(), k_threads * k_perThread - 10);
+    CHECK(recent == expected);
+
+    std::vector<int> all = ring.mostRecent(100000);
+    CHECK(all.size() == k_threads * k_perThread);
+    CHECK(std::is_sorted(all.begin(), all.end()));
+
+    long long sum = ring.aggregate(
+        [](auto values) { long long partial = 0; for (int v : values) partial += v; return partial; },
+        [](long long left, long long right) { return left + right; });
+    CHECK(sum == (long long)(k_threads * k_perThread) * (k_threads * k_perThread - 1) / 2);
+}
+
+TEST_CASE("ShardedRing: shards drop their own oldest elements")
+{
+    ShardedRing<int> ring(3, 2);
+    for (int i = 0; i < 10; ++i)
+        ring.pushBack(i);       // same thread, same shard
+
+    CHECK(ring.size() == 3);
+    CHECK(ring.mostRecent(5) == std::vector<int>{7, 8, 9});
+}
+
+TEST_CASE("ShardedRing: caller's timestamps")
+{
+    ShardedRing<int> ring(3, 1);
+    for (int stamp : { 10, 20, 20, 25, 30 })   // equal stamps are fine, only going back isn't
+        ring.pushBackAt(static_cast<uint64_t>(stamp), stamp);
+
+    CHECK(ring.mostRecent(10) == std::vector<int>{20, 25, 30});
+    CHECK(ring.mostRecent(1) == std::vector<int>{30});
+}
@@ -0,0 +1,110 @@
+#include "doctest.h"
+
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "slidingWindowCounter.hpp"
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+TEST_CASE("SlidingWindowCounter: events leave the window slice by slice")
+{
+    SlidingWindowCounter<10> counter(100ms);    // 1 second window
+    CHECK(counter.window() == 1s);
+    CHECK(sizeof(counter) < 128);
+
+    const Clock::time_point start = Clock::time_point(1h);
+    counter.record(1, start);
+    counter.record(2, start + 50ms);            // same slice
+    counter.record(4, start + 500ms);
+    CHECK(counter.countInWindow(start + 500ms) == 7);
+    CHECK(counter.countInWindow(start + 999ms) == 7);
+    CHECK(counter.countInWindow(start + 1000ms) == 4);   // the first slice has expired
+    CHECK(counter.countInWindow(start + 1499ms) == 4);
+    CHECK(counter.countInWindow(start + 1500ms) == 0);
+
+    // long idle period, then a burst
+    counter.record(3, start + 1h);
+    CHECK(counter.countInWindow(start + 1h) == 3);
+}
+
+TEST_CASE("SlidingWindowCounter: rate limiting")
+{
+    SlidingWindowCounter<4> limiter(250ms);
+    const Clock::time_point start = Clock::time_point(1h);
+
+    int accepted = 0;
+    for (int i = 0; i < 20; ++i)
+        accepted += limiter.tryRecord(5, start + i * 10ms) ? 1 : 0;
+    CHECK(accepted == 5);
+
+    CHECK(!limiter.tryRecord(5, start + 999ms));
+    CHECK(limiter.tryRecord(5, start + 1000ms));        // the burst's slice has expired
+}
+
+TEST_CASE("SlidingWindowCounter: a slice's count saturates")
+{
+    SlidingWindowCounter<4> limiter(250ms);
+    const Clock::time_point start = Clock::time_point(1h);
+    constexpr uint32_t k_max = std::numeric_limits<uint32_t>::max();
+
+    limiter.record(k_max - 1, start);
+    limiter.record(k_max - 1, start);       // would wrap the slice's count
+    CHECK(limiter.countInWindow(start) == k_max);
+    CHECK(!limiter.tryRecord(5, start + 999ms));
+
+    // the whole slice leaves the window with the total
+    CHECK(limiter.countInWindow(start + 1000ms) == 0);
+    CHECK(limiter.tryRecord(5, start + 1000ms));
+}
+
+TEST_CASE("ConcurrentSlidingWindowCounter")
+{
+    ConcurrentSlidingWindowCounter<10> counter(100ms);
+    const Clock::time_point start = Clock::time_point(1h);
+
+    constexpr int k_threads = 4;
+    constexpr int k_events  = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < k_threads; ++t)
+        threads.emplace_back([&] { for (int i = 0; i < k_events; ++i) counter.record(1, start + (i % 10) * 100ms); });
+    for (std::thread& t : threads)
+        t.join();
+
+    CHECK(counter.countInWindow(start + 900ms) == k_threads * k_events);
+    CHECK(counter.countInWindow(start + 1000ms) == k_threads * k_events * 9 / 10);
+
+    // a new lap resets stale slots instead of adding to them
+    counter.record(1, start + 2000ms);
+    CHECK(counter.countInWindow(start + 2000ms) == 1);
+}
+
+TEST_CASE("ConcurrentSlidingWindowCounter: a stale timestamp doesn't reset a newer slice")
+{
+    ConcurrentSlidingWindowCounter<10> counter(100ms);
+    const Clock::time_point start = Clock::time_point(1h);
+
+    for (int i = 0; i < 100; ++i)
+        counter.record(1, start + 1000ms);
+
+    counter.record(1, start);       // same slot, one lap older: dropped
+    CHECK(counter.countInWindow(start + 1000ms) == 100);
+
+    counter.record(1, start + 1050ms);
+    CHECK(counter.countInWindow(start + 1000ms) == 101);
+}
+
+TEST_CASE("ConcurrentSlidingWindowCounter: a slice's count saturates")
+{
+    ConcurrentSlidingWindowCounter<10> counter(100ms);
+    const Clock::time_point start = Clock::time_point(1h);
+    constexpr uint32_t k_max = std::numeric_limits<uint32_t>::max();
+
+    counter.record(k_max - 1, start);
+    counter.record(k_max - 1, start);   // would carry into the slice index
+    counter.record(5, start + 100ms);
+    CHECK(counter.countInWindow(start + 100ms) == uint64_t(k_max) + 5);
+}
@@ -0,0 +1,125 @@
+#include "doctest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tieredHistory.hpp"
+
+namespace
+{
+    struct Tick
+    {
+        uint64_t m_time  = 0;
+        double   m_price = 0;
+    };
+
+    // a fresh directory for the segment files, removed afterwards. The random suffix keeps test runs which
+    // share the temp directory, e.g. ctest -j or several build trees, from deleting each other's files
+    struct ScratchDirectory
+    {
+        std::filesystem::path m_path;
+
+        explicit ScratchDirectory(const char* name)
+            : m_path(std::filesystem::temp_directory_path() / (std::string(name) + '_' + std::to_string(std::random_device()())))
+        {
+            std::filesystem::remove_all(m_path);
+        }
+
+        ~ScratchDirectory()
+        {
+            std::error_code ignored;
+            std::filesystem::remove_all(m_path, ignored);
+        }
+    };
+}
+
+TEST_CASE("TieredHistory: reads older than the ring come from the segment files")
+{
+    ScratchDirectory directory("tieredHistory_tests_reads");
+    {
+        TieredHistory<Tick> history(32, directory.m_path, 100, 16);
+
+        for (uint64_t i = 0; i < 1000; ++i)
+            history.pushBack(Tick{ i * 10, static_cast<double>(i) });
+
+        CHECK(history.size() == 1000);
+        CHECK(history.recent().size() == 32);
+        CHECK(history.recent().frontSequence() == 968);
+
+        // every tier: segments, batches in flight or being filled, the ring
+        for (uint64_t sequence = 0; sequence < 1000; sequence += 7)
+            CHECK(history.at(sequence).m_time == sequence * 10);
+        CHECK(history.at(999).m_price == 999.0);
+        CHECK_THROWS_AS(history.at(1000), std::out_of_range);
+
+        std::vector<uint64_t> times;
+        history.forEach(90, 1010, [&](const Tick& tick) { times.push_back(tick.m_time); });
+        REQUIRE(times.size() == 910);
+        for (size_t i = 0; i < times.size(); ++i)
+            CHECK(times[i] == (90 + i) * 10);
+
+        // index by time
+        CHECK(history.lowerBound(uint64_t(5555), [](const Tick& tick) { return tick.m_time; }) == 556);
+        CHECK(history.lowerBound(uint64_t(0), [](const Tick& tick) { return tick.m_time; }) == 0);
+        CHECK(history.lowerBound(uint64_t(1'000'000), [](const Tick& tick) { return tick.m_time; }) == 1000);
+
+        history.flush();
+        size_t files = 0;
+        for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator(directory.m_path))
+            ++files;
+        CHECK(files == 10);     // 968 spilled elements, 100 per segment
+    }
+}
+
+TEST_CASE("TieredHistory: the oldest segments are deleted")
+{
+    ScratchDirectory directory("tieredHistory_tests_retention");
+    {
+        TieredHistory<uint32_t> history(10, directory.m_path, 50, 8, 3);
+
+        for (uint32_t i = 0; i < 500; ++i)
+            history.pushBack(i);
+        history.flush();
+
+        // 490 spilled into segments of 50: only the last three, from 350, 400 and 450, are kept
+        CHECK(history.oldestSequence() == 350);
+        CHECK(history.size() == 150);
+        CHECK(history.at(350) == 350);
+        CHECK(history.at(489) == 489);
+        CHECK_THROWS_AS(history.at(349), std::out_of_range);
+
+        uint64_t sum = 0;
+        history.forEach(0, 500, [&](uint32_t value) { sum += value; });
+        CHECK(sum == (350 + 499) * 150 / 2);
+    }
+}
+
+TEST_CASE("TieredHistory: reads while the writer deletes old segments")
+{
+    ScratchDirectory directory("tieredHistory_tests_rotation");
+    {
+        TieredHistory<uint32_t> history(4, directory.m_path, 8, 2, 2);
+
+        // the writer deletes segments behind the reads: they skip what's gone instead of throwing
+        for (uint32_t i = 0; i < 5000; ++i)
+        {
+            history.pushBack(i);
+
+            uint64_t expected = history.oldestSequence();
+            bool     ordered  = true;
+            CHECK_NOTHROW(history.forEach(0, history.endSequence(), [&](uint32_t value)
+            {
+                ordered = ordered && value >= expected;
+                expected = value + 1;
+            }));
+            CHECK(ordered);
+
+            const uint64_t found = history.lowerBound(i / 2, [](uint32_t value) { return value; });
+            CHECK(found >= std::min<uint64_t>(i / 2, history.oldestSequence()));
+            CHECK(found <= std::max<uint64_t>(i / 2, history.oldestSequence()));
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include "doctest.h"
+
+#include <random>
+#include <vector>
+
+#include "timingWheel.hpp"
+
+namespace
+{
+    struct Timeout : TimerNode
+    {
+        int      m_id      = 0;
+        uint64_t m_firedAt = 0;
+    };
+
+    template <typename Wheel>
+    void runAndCheck(Wheel& wheel, std::vector<Timeout>& timers, uint64_t ticks)
+    {
+        wheel.advance(ticks, [&](TimerNode& node)
+        {
+            static_cast<Timeout&>(node).m_firedAt = wheel.now();
+        });
+
+        for (const Timeout& t : timers)
+            CHECK(t.m_firedAt == t.deadline());
+    }
+}
+
+TEST_CASE("TimingWheel: every timer fires exactly at its deadline")
+{
+    TimingWheel<3, 3> wheel(5);      // 8 slots per level, range of 512 ticks, deadlines go beyond it
+    std::vector<Timeout> timers(500);
+
+    std::mt19937 random(42);
+    for (size_t i = 0; i < timers.size(); ++i)
+        wheel.schedule(timers[i], wheel.now() + 1 + random() % 2000);
+
+    CHECK(wheel.size() == timers.size());
+    runAndCheck(wheel, timers, 2001);
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("TimingWheel: cancel, reschedule and schedule from the callback")
+{
+    TimingWheel<> wheel;
+    Timeout a, b, c;
+
+    wheel.scheduleAfter(a, 10);
+    wheel.scheduleAfter(b, 10);
+    wheel.scheduleAfter(c, 5000);
+    wheel.cancel(b);
+    CHECK(!b.scheduled());
+    CHECK(wheel.size() == 2);
+
+    wheel.schedule(c, 20);      // moves it closer
+    CHECK(c.deadline() == 20);
+
+    std::vector<std::pair<uint64_t, TimerNode*>> fired;
+    auto onExpired = [&](TimerNode& node)
+    {
+        fired.emplace_back(wheel.now(), &node);
+        if (&node == &a && fired.size() == 1)
+            wheel.scheduleAfter(a, 3);      // periodic timer re-arms itself
+    };
+
+    CHECK(wheel.advance(30, onExpired) == 3);
+    CHECK(fired == std::vector<std::pair<uint64_t, TimerNode*>>{ {10, &a}, {13, &a}, {20, &c} });
+    CHECK(wheel.size() == 0);
+
+    // a deadline in the past expires on the next tick
+    wheel.schedule(a, 1);
+    CHECK(wheel.advance(1, onExpired) == 1);
+}
+
+TEST_CASE("TimingWheel: the callback may cancel a timer due at the same tick")
+{
+    TimingWheel<> wheel;
+    Timeout a, b;
+    wheel.scheduleAfter(a, 7);
+    wheel.scheduleAfter(b, 7);
+
+    size_t fired = wheel.advance(10, [&](TimerNode& node) { wheel.cancel(&node == &a ? b : a); });
+    CHECK(fired == 1);
+    CHECK(!a.scheduled());
+    CHECK(!b.scheduled());
+}
@@ -0,0 +1,72 @@
+#include "doctest.h"
+
+#include <string>
+#include <thread>
+
+#include "tripleBuffer.hpp"
+
+TEST_CASE("TripleBuffer: reader gets the latest published value")
+{
+    TripleBuffer<std::string> latest;
+
+    CHECK(!latest.hasUpdate());
+    CHECK(latest.read().empty());
+
+    latest.write("first");
+    CHECK(latest.hasUpdate());
+    CHECK(latest.read() == "first");
+    CHECK(!latest.hasUpdate());
+    CHECK(latest.read() == "first");   // still there, nothing new was published
+
+    // the writer overruns the reader: intermediate values are skipped, not queued
+    latest.write("second");
+    latest.write("third");
+    latest.backBuffer() = "fourth";
+    latest.publish();
+    CHECK(latest.read() == "fourth");
+    CHECK(!latest.update());
+    CHECK(latest.frontBuffer() == "fourth");
+}
+
+TEST_CASE("TripleBuffer: vector backend")
+{
+    TripleBuffer<int, VectorBuffer<int>> latest;
+    for (int i = 1; i <= 10; ++i)
+    {
+        latest.write(i);
+        if (i % 3 == 0)
+            CHECK(latest.read() == i);
+    }
+    CHECK(latest.read() == 10);
+}
+
+TEST_CASE("TripleBuffer: concurrent writer and reader")
+{
+    struct Sample
+    {
+        uint64_t m_sequence = 0;
+        uint64_t m_check    = 0;    // torn values would break the invariant m_check == ~m_sequence
+    };
+
+    constexpr uint64_t k_lastSequence = 200000;
+    TripleBuffer<Sample> latest;
+    latest.write(Sample{ 0, ~uint64_t(0) });
+
+    std::thread writer([&]
+    {
+        for (uint64_t i = 1; i <= k_lastSequence; ++i)
+            latest.write(Sample{ i, ~i });
+    });
+
+    uint64_t lastSeen = 0;
+    bool consistent = true;
+    while (lastSeen != k_lastSequence)
+    {
+        const Sample& sample = latest.read();
+        consistent = consistent && sample.m_check == ~sample.m_sequence && sample.m_sequence >= lastSeen;
+        lastSeen = sample.m_sequence;
+    }
+
+    writer.join();
+    CHECK(consistent);
+}
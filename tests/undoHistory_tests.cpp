@@ -0,0 +1,119 @@
+#include "doctest.h"
+
+#include <memory>
+#include <string>
+
+#include "undoHistory.hpp"
+
+namespace
+{
+    struct Insert
+    {
+        size_t      m_position = 0;
+        std::string m_text;
+    };
+
+    // typing: an insert right after the previous one extends it
+    bool mergeTyping(Insert& back, const Insert& incoming)
+    {
+        if (incoming.m_position != back.m_position + back.m_text.size())
+            return false;
+
+        back.m_text += incoming.m_text;
+        return true;
+    }
+
+    size_t textSize(const Insert& insert) { return insert.m_text.size(); }
+}
+
+TEST_CASE("UndoHistory: undo, redo, and a push drops the redo tail")
+{
+    UndoHistory<int> history(10, 1000);
+    CHECK_FALSE(history.canUndo());
+    CHECK(history.undo() == nullptr);
+
+    for (int i = 1; i <= 4; ++i)
+        history.push(i);
+
+    CHECK(*history.undo() == 4);
+    CHECK(*history.undo() == 3);
+    CHECK(history.undoCount() == 2);
+    CHECK(history.redoCount() == 2);
+    CHECK(*history.redo() == 3);
+
+    history.push(5);                        // 4 can't be redone anymore
+    CHECK_FALSE(history.canRedo());
+    CHECK(history.size() == 4);
+    CHECK(*history.undo() == 5);
+    CHECK(*history.undo() == 3);
+    CHECK(*history.redo() == 3);
+
+    // old commands fall off the front
+    for (int i = 6; i <= 20; ++i)
+        history.push(i);
+    CHECK(history.size() == 10);
+    CHECK(history.undoCount() == 10);
+
+    history.clear();
+    CHECK(history.empty());
+    CHECK(history.bytes() == 0);
+}
+
+TEST_CASE("UndoHistory: coalescing and the byte cap")
+{
+    UndoHistory<Insert, decltype(&textSize)> history(100, 10, &textSize);
+
+    history.push(Insert{ 0, "h" }, mergeTyping);
+    history.push(Insert{ 1, "e" }, mergeTyping);
+    history.push(Insert{ 2, "y" }, mergeTyping);
+    CHECK(history.size() == 1);
+    CHECK(history.bytes() == 3);
+
+    history.seal();                         // e.g. a pause
+    history.push(Insert{ 3, "!" }, mergeTyping);
+    CHECK(history.size() == 2);
+
+    history.push(Insert{ 0, ">> " }, mergeTyping);   // not adjacent
+    CHECK(history.size() == 3);
+    CHECK(history.bytes() == 7);
+
+    // the undone command is dropped with the redo tail
+    CHECK(history.undo()->m_text == ">> ");
+    history.push(Insert{ 10, "?" }, mergeTyping);
+    CHECK(history.size() == 3);
+    CHECK(history.bytes() == 5);            // the dropped redo tail doesn't count
+    CHECK(history.undo()->m_text == "?");
+    CHECK(history.redo()->m_text == "?");
+
+    // going over the cap evicts the oldest
+    history.push(Insert{ 20, "abcdef" }, mergeTyping);
+    CHECK(history.bytes() <= history.byteCap());
+    CHECK(history.size() == 3);
+    CHECK(history.undo()->m_text == "abcdef");
+    CHECK(history.undo()->m_text == "?");
+    CHECK(history.undo()->m_text == "!");
+    CHECK(history.undo() == nullptr);
+
+    // a single command larger than the cap is still kept
+    history.push(Insert{ 0, "0123456789ABC" });
+    CHECK(history.size() == 1);
+    CHECK(history.bytes() == 13);
+}
+
+TEST_CASE("UndoHistory: the redo tail's payloads are released with it")
+{
+    using Payload = std::shared_ptr<int>;
+    auto sizeOf = [](const Payload&) { return size_t(1); };
+    UndoHistory<Payload, decltype(sizeOf)> history(10, 100, sizeOf);
+
+    const Payload large = std::make_shared<int>(1);
+    for (int i = 0; i < 5; ++i)
+        history.push(large);
+    CHECK(large.use_count() == 6);
+
+    for (int i = 0; i < 4; ++i)
+        history.undo();
+    history.push(std::make_shared<int>(2));
+    CHECK(large.use_count() == 2);          // only the command which wasn't undone still holds it
+    CHECK(history.bytes() == 2);
+}
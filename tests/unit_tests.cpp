@@ -436,3 +436,282 @@ TEST_CASE("ranges: mostRecent and rvalue")
     bool areEqual = std::ranges::equal(mostRecent, std::vector<int>{1, 2});
     CHECK(areEqual);
 }
+
+TEST_CASE("forEachPrefetched visits elements in FIFO order across the wrap")
+{
+    struct Wide
+    {
+        int  m_value = 0;
+        char m_padding[200] = {};   // several cache lines per element
+    };
+
+    constexpr int k_size = 5;
+    CircularBuffer<Wide> buffer = CircularBuffer<Wide>(k_size);
+
+    for (int i = 0; i < k_size * 3; ++i)  // intentional overflow, so the content wraps
+    {
+        buffer.pushBack(Wide{ i });
+
+        const size_t distances[] = { 0, 1, 3, 100 };
+        for (size_t distance : distances)
+        {
+            std::vector<int> visited;
+            buffer.forEachPrefetched([&](Wide& w) { visited.push_back(w.m_value); }, distance);
+
+            std::vector<int> expected;
+            for (const Wide& w : buffer)
+                expected.push_back(w.m_value);
+
+            CHECK(visited == expected);
+        }
+    }
+
+    const CircularBuffer<Wide>& cref = buffer;
+    int sum = 0;
+    cref.forEachPrefetched([&](const Wide& w) { sum += w.m_value; });
+    CHECK(sum == 10 + 11 + 12 + 13 + 14);
+
+    CircularBuffer<Wide> empty = CircularBuffer<Wide>(k_size);
+    bool called = false;
+    empty.forEachPrefetched([&](Wide&) { called = true; });
+    CHECK(!called);
+}
+
+TEST_CASE("append() and appendStreaming() match a sequence of pushBack()")
+{
+    constexpr int k_size = 37;   // odd capacity, so segments start at unaligned offsets
+    std::vector<int> source(100);
+    for (int i = 0; i < (int)source.size(); ++i)
+        source[i] = i;
+
+    for (size_t chunk : { size_t(1), size_t(5), size_t(36), size_t(37), size_t(38), size_t(100) })
+    {
+        CircularBuffer<int> reference = CircularBuffer<int>(k_size);
+        CircularBuffer<int> appended  = CircularBuffer<int>(k_size);
+        CircularBuffer<int> streamed  = CircularBuffer<int>(k_size);
+
+        for (int round = 0; round < 4; ++round)
+        {
+            auto values = std::span<const int>(source).first(chunk);
+            for (int v : values)
+                reference.pushBack(v);
+            appended.append(values);
+            streamed.appendStreaming(values);
+
+            CHECK(appended.size() == reference.size());
+            CHECK(streamed.size() == reference.size());
+            CHECK(std::ranges::equal(appended, reference));
+            CHECK(std::ranges::equal(streamed, reference));
+        }
+    }
+
+    CircularBuffer<int> ints = CircularBuffer<int>(k_size);
+    ints.append({});
+    CHECK(ints.empty());
+    CHECK(ints.capacity() == k_size);
+}
+
+TEST_CASE("appendStreaming() of bytes with the std::array based buffer")
+{
+    constexpr int k_size = 100;
+    CircularBuffer<std::byte, ConstexprSizeBuffer<std::byte, k_size>> bytes;
+    std::vector<std::byte> reference;
+
+    std::vector<std::byte> chunk(71);
+    for (int round = 0; round < 10; ++round)
+    {
+        for (size_t i = 0; i < chunk.size(); ++i)
+            chunk[i] = static_cast<std::byte>(round * 7 + i);
+
+        bytes.appendStreaming(chunk);
+        reference.insert(reference.end(), chunk.begin(), chunk.end());
+
+        size_t expectedSize = std::min<size_t>(reference.size(), k_size);
+        CHECK(bytes.size() == expectedSize);
+        CHECK(std::ranges::equal(bytes, std::span(reference).last(expectedSize)));
+    }
+}
+
+TEST_CASE("claim() and publish()")
+{
+    constexpr int k_size = 5;
+    CircularBuffer<int> ints = CircularBuffer<int>(k_size);
+    std::vector<int> reference;
+    int next = 0;
+
+    for (size_t requested : { size_t(2), size_t(3), size_t(4), size_t(1), size_t(10) })
+    {
+        // make some room, so claims start at different positions and eventually wrap
+        ints.popFront();
+        ints.popFront();
+        reference.erase(reference.begin(), reference.begin() + std::min<size_t>(2, reference.size()));
+
+        SpanPair<int> slots = ints.claim(requested);
+        CHECK(slots.size() == std::min(requested, ints.capacity() - ints.size()));
+
+        for (int& slot : slots.m_first)
+            slot = next++;
+        for (int& slot : slots.m_second)
+            slot = next++;
+
+        // only part of the claimed slots gets published
+        size_t published = slots.size() > 1 ? slots.size() - 1 : slots.size();
+        ints.publish(published);
+        for (size_t i = 0; i < published; ++i)
+            reference.push_back(next - (int)slots.size() + (int)i);
+        next -= (int)(slots.size() - published);
+
+        CHECK(ints.size() == reference.size());
+        CHECK(std::ranges::equal(ints, reference));
+    }
+
+    // full buffer has nothing to claim
+    while (ints.size() < ints.capacity())
+        ints.pushBack(0);
+    CHECK(ints.claim(3).empty());
+}
+
+TEST_CASE("peek() and release()")
+{
+    constexpr int k_size = 5;
+    CircularBuffer<int> ints = CircularBuffer<int>(k_size);
+
+    for (int i = 0; i < k_size + 3; ++i)   // intentional overflow: contents wrap
+        ints.pushBack(i);
+
+    const CircularBuffer<int>& cref = ints;
+    SpanPair<const int> all = cref.peek(100);
+    CHECK(all.size() == ints.size());
+    CHECK(!all.m_second.empty());
+
+    std::vector<int> peeked(all.m_first.begin(), all.m_first.end());
+    peeked.insert(peeked.end(), all.m_second.begin(), all.m_second.end());
+    CHECK(std::ranges::equal(peeked, ints));
+
+    // modify in place through the non-const spans
+    SpanPair<int> some = ints.peek(2);
+    CHECK(some.size() == 2);
+    for (int& v : some.m_first)
+        v *= 10;
+    for (int& v : some.m_second)
+        v *= 10;
+    CHECK(ints.front() == 30);
+
+    ints.release(2);
+    CHECK(ints.size() == k_size - 2);
+    CHECK(ints.front() == 5);
+
+    ints.release(ints.size());
+    CHECK(ints.empty());
+    CHECK(ints.peek(1).empty());
+}
+
+TEST_CASE("sequence numbers: sequenceOf(), at(), since()")
+{
+    constexpr int k_size = 4;
+    CircularBuffer<int> ints = CircularBuffer<int>(k_size);
+
+    CHECK(ints.frontSequence() == 0);
+    CHECK(ints.endSequence() == 0);
+    CHECK_THROWS_AS(ints.at(0), std::out_of_range);
+
+    // value == its sequence number
+    for (int i = 0; i < 10; ++i)
+    {
+        ints.pushBack(i);
+        CHECK(ints.sequenceOf(ints.back()) == (uint64_t)i);
+        CHECK(ints.sequenceOf(ints.front()) == ints.frontSequence());
+        CHECK(ints.endSequence() == (uint64_t)i + 1);
+    }
+
+    CHECK(ints.frontSequence() == 6);
+    for (uint64_t seq = 6; seq < 10; ++seq)
+        CHECK(ints.at(seq) == (int)seq);
+    CHECK_THROWS_AS(ints.at(5), std::out_of_range);   // evicted
+    CHECK_THROWS_AS(ints.at(10), std::out_of_range);  // not pushed yet
+    for (size_t index = 0; index < ints.size(); ++index)
+        CHECK(ints[index] == ints.at(ints.frontSequence() + index));   // unchecked, across the wrap
+
+    CHECK(std::ranges::equal(ints.since(8), std::vector<int>{8, 9}));
+    CHECK(std::ranges::equal(ints.since(0), std::vector<int>{6, 7, 8, 9}));   // late reader resumes at the oldest
+    CHECK(std::ranges::empty(ints.since(10)));
+
+    // every way of removing elements keeps numbering consistent
+    ints.popFront();
+    CHECK(ints.front() == (int)ints.frontSequence());
+    ints.release(1);
+    CHECK(ints.front() == (int)ints.frontSequence());
+
+    const int more[] = { 10, 11, 12, 13, 14, 15 };
+    ints.append(more);
+    CHECK(ints.frontSequence() == 12);
+    CHECK(ints.at(13) == 13);
+
+    SpanPair<int> slots = ints.claim(1);
+    CHECK(slots.empty());   // full
+    ints.release(2);
+    slots = ints.claim(1);
+    slots.m_first.empty() ? (void)(slots.m_second[0] = 16) : (void)(slots.m_first[0] = 16);
+    ints.publish(1);
+    CHECK(ints.at(16) == 16);
+
+    // copies and moves carry the numbering along
+    CircularBuffer<int> copy = ints;
+    CHECK(copy.frontSequence() == ints.frontSequence());
+    CHECK(copy.at(15) == 15);
+    CircularBuffer<int> moved = std::move(copy);
+    CHECK(moved.at(16) == 16);
+}
+
+TEST_CASE("popBack() and truncateFrom()")
+{
+    constexpr int k_size = 4;
+    CircularBuffer<int> ints = CircularBuffer<int>(k_size);
+    ints.popBack();
+    CHECK(ints.empty());
+
+    for (int i = 0; i < 6; ++i)
+        ints.pushBack(i);                   // the tail has wrapped: {2, 3, 4, 5}
+
+    ints.popBack();
+    CHECK(ints.back() == 4);
+    CHECK(ints.endSequence() == 5);
+
+    ints.pushBack(5);
+    ints.truncateFrom(3);                   // across the buffer edge
+    CHECK(std::ranges::equal(ints, std::vector<int>{2}));
+    CHECK(ints.endSequence() == 3);
+
+    ints.truncateFrom(100);                 // nothing from there on
+    CHECK(ints.size() == 1);
+
+    ints.pushBack(3);
+    CHECK(ints.at(3) == 3);
+    ints.truncateFrom(ints.frontSequence());
+    CHECK(ints.empty());
+    CHECK(ints.frontSequence() == 2);
+}
+
+TEST_CASE("pushOrMerge() conflates consecutive updates of a key")
+{
+    struct Update
+    {
+        int m_key   = 0;
+        int m_count = 0;
+    };
+
+    auto sameKey = [](const Update& back, const Update& value) { return back.m_key == value.m_key; };
+    auto merge   = [](Update& back, const Update& value) { back.m_count += value.m_count; };
+
+    CircularBuffer<Update> updates(3);
+    const int keys[] = { 1, 1, 1, 2, 2, 1, 3, 3, 3, 3 };
+    for (int key : keys)
+        updates.pushOrMerge(Update{ key, 1 }, sameKey, merge);
+
+    REQUIRE(updates.size() == 3);
+    CHECK(updates.front().m_key == 2);
+    CHECK(updates.front().m_count == 2);
+    CHECK(updates.back().m_key == 3);
+    CHECK(updates.back().m_count == 4);
+    CHECK(updates.endSequence() == 4);    // merges don't take sequence numbers
+}
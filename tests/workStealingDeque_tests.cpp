@@ -0,0 +1,88 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "workStealingDeque.hpp"
+
+TEST_CASE("WorkStealingDeque: owner pops LIFO, thief steals FIFO")
+{
+    WorkStealingDeque<int> deque(2);
+    CHECK(deque.empty());
+    CHECK(!deque.pop());
+    CHECK(!deque.steal());
+
+    for (int i = 0; i < 10; ++i)   // grows a few times
+        deque.push(i);
+    CHECK(deque.size() == 10);
+
+    CHECK(deque.steal() == 0);
+    CHECK(deque.steal() == 1);
+    CHECK(deque.pop() == 9);
+    CHECK(deque.pop() == 8);
+    CHECK(deque.size() == 6);
+
+    std::vector<int> rest;
+    while (auto value = deque.pop())
+        rest.push_back(*value);
+    CHECK(rest == std::vector<int>{7, 6, 5, 4, 3, 2});
+    CHECK(deque.empty());
+
+    deque.push(42);
+    CHECK(deque.steal() == 42);
+    CHECK(!deque.pop());
+}
+
+TEST_CASE("WorkStealingDeque: every element is taken exactly once under concurrent stealing")
+{
+    constexpr int k_items   = 100000;
+    constexpr int k_thieves = 3;
+
+    WorkStealingDeque<int> deque(4);
+    std::vector<std::atomic<int>> taken(k_items);
+    std::atomic<int> takenCount = 0;
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < k_thieves; ++t)
+    {
+        thieves.emplace_back([&]
+        {
+            while (takenCount.load() < k_items)
+            {
+                if (auto value = deque.steal())
+                {
+                    taken[*value].fetch_add(1);
+                    takenCount.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    // owner interleaves pushes and pops
+    for (int i = 0; i < k_items; ++i)
+    {
+        deque.push(i);
+        if (i % 3 == 0)
+        {
+            if (auto value = deque.pop())
+            {
+                taken[*value].fetch_add(1);
+                takenCount.fetch_add(1);
+            }
+        }
+    }
+
+    while (auto value = deque.pop())
+    {
+        taken[*value].fetch_add(1);
+        takenCount.fetch_add(1);
+    }
+
+    for (std::thread& t : thieves)
+        t.join();
+
+    CHECK(takenCount.load() == k_items);
+    CHECK(std::all_of(taken.begin(), taken.end(), [](const std::atomic<int>& count) { return count.load() == 1; }));
+}